@@ -0,0 +1,301 @@
+/**
+@file PerfCounter.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "PerfCounter.h"
+
+#ifdef LCORE_PERF_COUNTER
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace lcore
+{
+    namespace
+    {
+        /**
+        @brief A group of counters of the calling thread, opened on first use and kept running
+        */
+        class PerfCounterGroup
+        {
+        public:
+            PerfCounterGroup()
+                :leader_(-1)
+                ,num_(0)
+            {
+                for(u32 i=0; i<PerfCounterEvent_Num; ++i){
+                    fds_[i] = -1;
+                    events_[i] = PerfCounterEvent_Num;
+                }
+                open();
+            }
+
+            ~PerfCounterGroup()
+            {
+#if defined(__linux__)
+                for(u32 i=0; i<num_; ++i){
+                    close(fds_[i]);
+                }
+#endif
+            }
+
+            bool isAvailable() const
+            {
+                return 0<=leader_;
+            }
+
+            /**
+            @brief Read current counts, and the times the group was enabled and running
+            */
+            bool read(u64 counts[PerfCounterEvent_Num], u64& enabled, u64& running) const
+            {
+                for(u32 i=0; i<PerfCounterEvent_Num; ++i){
+                    counts[i] = 0;
+                }
+                enabled = running = 0;
+#if defined(__linux__)
+                if(leader_<0){
+                    return false;
+                }
+                //PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING: nr, enabled, running, values[nr]
+                u64 buffer[3+PerfCounterEvent_Num];
+                ssize_t size = ::read(leader_, buffer, sizeof(buffer));
+                if(size<static_cast<ssize_t>(sizeof(u64)*3) || buffer[0] != num_){
+                    return false;
+                }
+                enabled = buffer[1];
+                running = buffer[2];
+                for(u32 i=0; i<num_; ++i){
+                    counts[events_[i]] = buffer[3+i];
+                }
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            u32 getValidMask() const
+            {
+                u32 mask = 0;
+                for(u32 i=0; i<num_; ++i){
+                    mask |= 1U<<events_[i];
+                }
+                return mask;
+            }
+
+        private:
+            void open()
+            {
+#if defined(__linux__)
+                static const u32 types[PerfCounterEvent_Num] =
+                {
+                    PERF_TYPE_HARDWARE,
+                    PERF_TYPE_HARDWARE,
+                    PERF_TYPE_HARDWARE,
+                    PERF_TYPE_HW_CACHE,
+                };
+                static const u64 configs[PerfCounterEvent_Num] =
+                {
+                    PERF_COUNT_HW_CPU_CYCLES,
+                    PERF_COUNT_HW_INSTRUCTIONS,
+                    PERF_COUNT_HW_BRANCH_MISSES,
+                    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ<<8) | (PERF_COUNT_HW_CACHE_RESULT_MISS<<16),
+                };
+
+                //Events the hardware does not have are left out of the group
+                for(u32 i=0; i<PerfCounterEvent_Num; ++i){
+                    perf_event_attr attr;
+                    memset(&attr, 0, sizeof(attr));
+                    attr.size = sizeof(attr);
+                    attr.type = types[i];
+                    attr.config = configs[i];
+                    attr.disabled = (leader_<0)? 1 : 0;
+                    attr.exclude_kernel = 1;
+                    attr.exclude_hv = 1;
+                    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                    int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, leader_, 0));
+                    if(fd<0){
+                        if(i == PerfCounterEvent_Cycles){
+                            return;
+                        }
+                        continue;
+                    }
+                    if(leader_<0){
+                        leader_ = fd;
+                    }
+                    fds_[num_] = fd;
+                    events_[num_] = static_cast<PerfCounterEvent>(i);
+                    ++num_;
+                }
+                ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+            }
+
+            int leader_;
+            u32 num_;
+            int fds_[PerfCounterEvent_Num];
+            PerfCounterEvent events_[PerfCounterEvent_Num];
+        };
+
+        PerfCounterGroup& getPerfCounterGroup()
+        {
+            static thread_local PerfCounterGroup group;
+            return group;
+        }
+
+        struct PerfCounterRegion
+        {
+            std::string name_;
+            PerfCounterValues values_;
+        };
+
+        struct PerfCounterRegions
+        {
+            std::mutex mutex_;
+            std::vector<PerfCounterRegion> regions_;
+        };
+
+        PerfCounterRegions& getPerfCounterRegions()
+        {
+            static PerfCounterRegions regions;
+            return regions;
+        }
+
+        void accumulate(const Char* name, u64 values, const u64 counts[PerfCounterEvent_Num], u32 valid)
+        {
+            PerfCounterRegions& regions = getPerfCounterRegions();
+            std::lock_guard<std::mutex> lock(regions.mutex_);
+            PerfCounterRegion* region = NULL;
+            for(size_t i=0; i<regions.regions_.size(); ++i){
+                if(regions.regions_[i].name_ == name){
+                    region = &regions.regions_[i];
+                    break;
+                }
+            }
+            if(NULL == region){
+                regions.regions_.push_back(PerfCounterRegion());
+                region = &regions.regions_.back();
+                region->name_ = name;
+                memset(&region->values_, 0, sizeof(PerfCounterValues));
+                region->values_.valid_ = valid;
+            }
+            PerfCounterValues& v = region->values_;
+            ++v.scopes_;
+            v.values_ += values;
+            for(u32 i=0; i<PerfCounterEvent_Num; ++i){
+                v.counts_[i] += counts[i];
+            }
+            v.valid_ &= valid;
+        }
+
+        f64 perValue(const PerfCounterValues& values, PerfCounterEvent event)
+        {
+            return (0<values.values_)? static_cast<f64>(values.counts_[event])/values.values_ : 0.0;
+        }
+    }
+
+    bool isPerfCounterAvailable()
+    {
+        return getPerfCounterGroup().isAvailable();
+    }
+
+    bool getPerfCounters(const Char* name, PerfCounterValues& values)
+    {
+        PerfCounterRegions& regions = getPerfCounterRegions();
+        std::lock_guard<std::mutex> lock(regions.mutex_);
+        for(size_t i=0; i<regions.regions_.size(); ++i){
+            if(regions.regions_[i].name_ == name){
+                values = regions.regions_[i].values_;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void printPerfCounters(FILE* file)
+    {
+        PerfCounterRegions& regions = getPerfCounterRegions();
+        std::lock_guard<std::mutex> lock(regions.mutex_);
+        if(regions.regions_.empty()){
+            fprintf(file, "perf counters: no regions%s\n", isPerfCounterAvailable()? "" : " (perf_event_open is not available)");
+            return;
+        }
+        fprintf(file, "%-36s %12s %8s %12s %14s %14s\n", "name", "values", "IPC", "cycles/value", "br-miss/value", "L1D-miss/value");
+        for(size_t i=0; i<regions.regions_.size(); ++i){
+            const PerfCounterRegion& region = regions.regions_[i];
+            const PerfCounterValues& v = region.values_;
+            fprintf(file, "%-36s %12llu", region.name_.c_str(), static_cast<unsigned long long>(v.values_));
+            if(0 == (v.valid_ & (1U<<PerfCounterEvent_Cycles))){
+                fprintf(file, " %8s %12s %14s %14s\n", "-", "-", "-", "-");
+                continue;
+            }
+            if(v.valid_ & (1U<<PerfCounterEvent_Instructions)){
+                f64 ipc = (0<v.counts_[PerfCounterEvent_Cycles])? static_cast<f64>(v.counts_[PerfCounterEvent_Instructions])/v.counts_[PerfCounterEvent_Cycles] : 0.0;
+                fprintf(file, " %8.3f", ipc);
+            }else{
+                fprintf(file, " %8s", "-");
+            }
+            fprintf(file, " %12.3f", perValue(v, PerfCounterEvent_Cycles));
+            static const PerfCounterEvent misses[] = {PerfCounterEvent_BranchMisses, PerfCounterEvent_L1DMisses};
+            for(u32 j=0; j<2; ++j){
+                if(v.valid_ & (1U<<misses[j])){
+                    fprintf(file, " %14.6f", perValue(v, misses[j]));
+                }else{
+                    fprintf(file, " %14s", "-");
+                }
+            }
+            fprintf(file, "\n");
+        }
+    }
+
+    void resetPerfCounters()
+    {
+        PerfCounterRegions& regions = getPerfCounterRegions();
+        std::lock_guard<std::mutex> lock(regions.mutex_);
+        regions.regions_.clear();
+    }
+
+    //---------------------------------------------
+    //---
+    //--- PerfCounterScope
+    //---
+    //---------------------------------------------
+    PerfCounterScope::PerfCounterScope(const Char* name, u64 values)
+        :name_(name)
+        ,values_(values)
+    {
+        started_ = getPerfCounterGroup().read(start_, startEnabled_, startRunning_);
+    }
+
+    PerfCounterScope::~PerfCounterScope()
+    {
+        u64 end[PerfCounterEvent_Num];
+        u64 enabled, running;
+        PerfCounterGroup& group = getPerfCounterGroup();
+        if(!started_ || !group.read(end, enabled, running)){
+            u64 zero[PerfCounterEvent_Num] = {};
+            accumulate(name_, values_, zero, 0);
+            return;
+        }
+        //Scale up if the group was multiplexed with other events
+        u64 deltaEnabled = enabled - startEnabled_;
+        u64 deltaRunning = running - startRunning_;
+        f64 scale = (0<deltaRunning && deltaRunning<deltaEnabled)? static_cast<f64>(deltaEnabled)/deltaRunning : 1.0;
+        u64 counts[PerfCounterEvent_Num];
+        for(u32 i=0; i<PerfCounterEvent_Num; ++i){
+            counts[i] = static_cast<u64>(static_cast<f64>(end[i]-start_[i])*scale);
+        }
+        accumulate(name_, values_, counts, (0<deltaRunning)? group.getValidMask() : 0);
+    }
+}
+#endif
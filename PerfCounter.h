@@ -0,0 +1,112 @@
+#ifndef INC_PERFCOUNTER_H_
+#define INC_PERFCOUNTER_H_
+/**
+@file PerfCounter.h
+@author t-sakai
+@date 2026/10/17 create
+
+Hardware performance counters around generator loops, with Linux perf_event_open.
+
+    {
+        LCORE_PERF_SCOPE("RandWELL::fill", count);
+        random.fill(buffer, count);
+    }
+    lcore::printPerfCounters(stdout);
+
+Counters are read when a scope begins and ends, and the differences are accumulated by name.
+A region should be long enough that the two read system calls are negligible.
+Without LCORE_PERF_COUNTER defined, every class and function here is an empty inline and LCORE_PERF_SCOPE expands to nothing.
+*/
+#include <cstdio>
+#include "Random.h"
+
+namespace lcore
+{
+    enum PerfCounterEvent
+    {
+        PerfCounterEvent_Cycles = 0,
+        PerfCounterEvent_Instructions,
+        PerfCounterEvent_BranchMisses,
+        PerfCounterEvent_L1DMisses,
+        PerfCounterEvent_Num,
+    };
+
+    /**
+    @brief Accumulated counts of a named region
+    */
+    struct PerfCounterValues
+    {
+        u64 scopes_; //!< Number of times the region ran
+        u64 values_; //!< Number of values generated in the region
+        u64 counts_[PerfCounterEvent_Num];
+        u32 valid_; //!< Bit i is set if counts_[i] was counted
+    };
+
+#ifdef LCORE_PERF_COUNTER
+    /**
+    @brief Whether counters can be opened by this thread
+    */
+    bool isPerfCounterAvailable();
+
+    /**
+    @brief Counts of the region, false if it has not run
+    */
+    bool getPerfCounters(const Char* name, PerfCounterValues& values);
+
+    /**
+    @brief Print the counts per value of all regions
+    */
+    void printPerfCounters(FILE* file);
+
+    void resetPerfCounters();
+
+    /**
+    @brief Count from construction to destruction, and accumulate into the region of name
+    */
+    class PerfCounterScope
+    {
+    public:
+        /**
+        @param name ... copied when the scope ends, so it has to live until then
+        @param values ... number of values generated in the scope
+        */
+        PerfCounterScope(const Char* name, u64 values);
+        ~PerfCounterScope();
+
+        void setValues(u64 values)
+        {
+            values_ = values;
+        }
+    private:
+        PerfCounterScope(const PerfCounterScope&) = delete;
+        PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+
+        const Char* name_;
+        u64 values_;
+        u64 start_[PerfCounterEvent_Num];
+        u64 startEnabled_;
+        u64 startRunning_;
+        bool started_;
+    };
+
+#define LCORE_PERF_CONCAT_IMPL(x, y) x ## y
+#define LCORE_PERF_CONCAT(x, y) LCORE_PERF_CONCAT_IMPL(x, y)
+#define LCORE_PERF_SCOPE(name, values) lcore::PerfCounterScope LCORE_PERF_CONCAT(perfCounterScope_, __LINE__)(name, values)
+
+#else
+    inline bool isPerfCounterAvailable(){ return false;}
+    inline bool getPerfCounters(const Char*, PerfCounterValues&){ return false;}
+    inline void printPerfCounters(FILE*){}
+    inline void resetPerfCounters(){}
+
+    class PerfCounterScope
+    {
+    public:
+        PerfCounterScope(const Char*, u64){}
+        void setValues(u64){}
+    };
+
+#define LCORE_PERF_SCOPE(name, values) ((void)0)
+#endif
+}
+#endif //INC_PERFCOUNTER_H_
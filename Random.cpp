@@ -4,6 +4,18 @@
 @date 2011/09/04
 */
 #include "Random.h"
+#include "RandomEngine.h"
+#include "RandomKernel.h"
+#include "RandomCrypt.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 #ifdef _WIN32
 #if !defined(WIN32_LEAN_AND_MEAN)
@@ -59,46 +71,6 @@ namespace lcore
     }
 
 #endif
-        u32 getRandomBasedOnDisckUsage()
-        {
-            u32 t = getTimeMilliSec();
-            lcore::ClockType counter = getPerformanceCounter();
-
-#ifdef _WIN32
-            LARGE_INTEGER freeBytesAvalable;
-            LARGE_INTEGER totalBytes;
-            LARGE_INTEGER totalFreeBytes;
-
-            u32 discBytes = 0;
-            BOOL ret = GetDiskFreeSpaceEx(
-                NULL,
-                (PULARGE_INTEGER)&freeBytesAvalable,
-                (PULARGE_INTEGER)&totalBytes,
-                (PULARGE_INTEGER)&totalFreeBytes);
-
-            if(ret){
-                discBytes = totalFreeBytes.LowPart;
-            }
-
-            MEMORYSTATUSEX memstat;
-
-            GlobalMemoryStatusEx(&memstat);
-            u32 memoryBytes = static_cast<u32>(memstat.ullAvailPhys & 0xFFFFFFFFU);
-#else
-            struct sysinfo info;
-            sysinfo(&info);
-            u32 memoryBytes = static_cast<u32>(info.freeram & 0xFFFFFFFFU);
-
-            u32 discBytes = 0;
-            struct statvfs statFs;
-            if(0 == statvfs("/", &statFs)){
-                discBytes = static_cast<u32>(statFs.f_bfree & 0xFFFFFFFU);
-            }
-#endif
-            u32 other = ( (discBytes<<16) | (memoryBytes & 0xFFFFU));
-            return ((t<<16) | static_cast<u32>(counter&0xFFFFU)) ^ other;
-        }
-
         u64 getRandomBasedOnDisckUsage64()
         {
             u32 t = getTimeMilliSec();
@@ -139,6 +111,27 @@ namespace lcore
             return ((counter<<32) | t) ^ other;
         }
 
+
+        u64 readTimeStamp()
+        {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+            return __rdtsc();
+#else
+            return static_cast<u64>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        /**
+        @brief System entropy, or the old sources if the system has none
+        */
+        u64 getEntropy64()
+        {
+            u64 entropy;
+            if(!getSystemEntropy(&entropy, sizeof(entropy))){
+                entropy = getRandomBasedOnDisckUsage64();
+            }
+            return entropy ^ readTimeStamp();
+        }
     }
 
     u32 scramble(u32 v, u32 i)
@@ -158,7 +151,7 @@ namespace lcore
 
     u32 getDefaultSeed()
     {
-        return getRandomBasedOnDisckUsage();
+        return static_cast<u32>(getDefaultSeed64()>>32);
     }
 
     u64 getStaticSeed64()
@@ -168,7 +161,11 @@ namespace lcore
 
     u64 getDefaultSeed64()
     {
-        return getRandomBasedOnDisckUsage64();
+        //The time stamp of each call also separates the parent and the child of a fork
+        static const u64 entropy = getEntropy64();
+        static std::atomic<u64> count(0);
+        const u64 c = count.fetch_add(1, std::memory_order_relaxed);
+        return SplitMix64::mix((entropy ^ readTimeStamp()) + (c+1)*SplitMix64::Gamma);
     }
 
     namespace
@@ -189,7 +186,9 @@ namespace lcore
             static const u32 m0 = 0x3F800000U;
             static const u32 m1 = 0x007FFFFFU;
             x = m0|(x&m1);
-            return (*(f32*)&x)- 0.999999881f;
+            f32 f;
+            memcpy(&f, &x, sizeof(f32));
+            return f - 0.999999881f;
         }
 
         // Return [0, 1)
@@ -198,20 +197,214 @@ namespace lcore
             static const u32 m0 = 0x3F800000U;
             static const u32 m1 = 0x007FFFFFU;
             x = m0|(x&m1);
-            return (*(f32*)&x) - 1.000000000f;
+            f32 f;
+            memcpy(&f, &x, sizeof(f32));
+            return f - 1.000000000f;
         }
 
         // Return [0, 1)
         inline f64 toF64(u64 x)
         {
-            union U
+            x = u64(0x3FF) << 52 | x >> 12;
+            f64 d;
+            memcpy(&d, &x, sizeof(f64));
+            return d - 1.0;
+        }
+
+        // Return [0, 1) of 53 bits
+        inline f64 toF64(u32 high, u32 low)
+        {
+            return static_cast<f64>(((static_cast<u64>(high)<<32) | low)>>11) * (1.0/9007199254740992.0);
+        }
+
+        inline u32 toU32(u32 x)
+        {
+            return x;
+        }
+
+        /**
+        @brief Doubles of 53 bits from pairs of fill
+        */
+        template<class T>
+        void fillPairF64(T& random, f64* out, size_t n)
+        {
+            static const u32 BlockSize = 512;
+            const RandomKernels::ConvertPairF64 convert = getRandomKernels().pairToF64Full_1_;
+            u32 block[2*BlockSize];
+            while(0<n){
+                u32 count = (BlockSize<n)? BlockSize : static_cast<u32>(n);
+                random.fill(block, 2*count);
+                convert(out, block, count);
+                out += count;
+                n -= count;
+            }
+        }
+
+        //---------------------------------------------
+        //--- Steps of the engines of RandomEngine.h, for jumpState
+        inline void nextXoshiro128(u32 state[4])
+        {
+            Xoshiro128PlusEngine::step(state);
+        }
+
+        inline void nextXoroshiro128(u64 state[2])
+        {
+            Xoroshiro128PlusEngine::step(state);
+        }
+
+        inline void nextXoshiro256(u64 state[4])
+        {
+            Xoroshiro256PlusEngine::step(state);
+        }
+
+        inline void nextXoshiro512(u64 state[8])
+        {
+            Xoroshiro512PlusEngine::step(state);
+        }
+
+        /**
+        @brief Apply a jump polynomial, state becomes the sum of the states at the set bits of table
+        */
+        template<class T, u32 N>
+        void jumpState(T state[N], const T table[N], void (*next)(T*))
+        {
+            static const u32 Bits = sizeof(T)*8;
+            T s[N] = {};
+            for(u32 i=0; i<N; ++i){
+                for(u32 b=0; b<Bits; ++b){
+                    if(table[i] & (static_cast<T>(1)<<b)){
+                        for(u32 j=0; j<N; ++j){
+                            s[j] ^= state[j];
+                        }
+                    }
+                    next(state);
+                }
+            }
+            for(u32 j=0; j<N; ++j){
+                state[j] = s[j];
+            }
+        }
+
+        static const u32 JumpXoshiro128[] = {0x8764000bU, 0xf542d2d3U, 0x6fa035c3U, 0x77f2db5bU};
+
+        /**
+        @brief The 2^64 steps jump of Xoshiro128 as a linear map, tabulated for each 4 bits of the state
+
+        The jump is linear over GF(2), so the jumped state is the xor of the jumped 4 bits groups.
+        32 lookups replace the 128 steps of jumpState.
+        */
+        struct JumpTableXoshiro128
+        {
+            static const u32 Nibbles = 32;
+
+            JumpTableXoshiro128()
+            {
+                for(u32 i=0; i<Nibbles; ++i){
+                    u32 columns[4][4];
+                    for(u32 bit=0; bit<4; ++bit){
+                        const u32 position = 4*i + bit;
+                        u32* column = columns[bit];
+                        column[0] = column[1] = column[2] = column[3] = 0;
+                        column[position>>5] = 1U<<(position&31);
+                        jumpState<u32, 4>(column, JumpXoshiro128, nextXoshiro128);
+                    }
+                    for(u32 value=0; value<16; ++value){
+                        u32* entry = table_[i][value];
+                        entry[0] = entry[1] = entry[2] = entry[3] = 0;
+                        for(u32 bit=0; bit<4; ++bit){
+                            if(value & (1U<<bit)){
+                                entry[0] ^= columns[bit][0];
+                                entry[1] ^= columns[bit][1];
+                                entry[2] ^= columns[bit][2];
+                                entry[3] ^= columns[bit][3];
+                            }
+                        }
+                    }
+                }
+                LASSERT(equalsJumpState());
+            }
+
+            void jump(u32 state[4]) const
             {
-                u64 i_;
-                f64 d_;
-            };
-            U u;
-            u.i_ = u64(0x3FF) << 52 | x >> 12;
-            return u.d_ - 1.0;
+                u32 s[4] = {0, 0, 0, 0};
+                for(u32 i=0; i<Nibbles; ++i){
+                    const u32* entry = table_[i][(state[i>>3] >> (4*(i&7))) & 0xFU];
+                    s[0] ^= entry[0];
+                    s[1] ^= entry[1];
+                    s[2] ^= entry[2];
+                    s[3] ^= entry[3];
+                }
+                state[0] = s[0];
+                state[1] = s[1];
+                state[2] = s[2];
+                state[3] = s[3];
+            }
+
+            /**
+            @brief Compare with jumpState on states from SplitMix64
+            */
+            bool equalsJumpState() const
+            {
+                SplitMix64 splitMix(0x5DEECE66DULL);
+                for(u32 i=0; i<64; ++i){
+                    const u64 t0 = splitMix.rand();
+                    const u64 t1 = splitMix.rand();
+                    u32 expected[4] = {static_cast<u32>(t0), static_cast<u32>(t0>>32), static_cast<u32>(t1), static_cast<u32>(t1>>32)};
+                    u32 state[4] = {expected[0], expected[1], expected[2], expected[3]};
+                    jumpState<u32, 4>(expected, JumpXoshiro128, nextXoshiro128);
+                    jump(state);
+                    if(expected[0] != state[0] || expected[1] != state[1] || expected[2] != state[2] || expected[3] != state[3]){
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            u32 table_[Nibbles][16][4];
+        };
+
+        // Advance 2^64 steps
+        void jumpXoshiro128(u32 state[4])
+        {
+            static const JumpTableXoshiro128 jumpTable;
+            jumpTable.jump(state);
+        }
+
+        // Advance 2^96 steps
+        void longJumpXoshiro128(u32 state[4])
+        {
+            static const u32 Jump[] = {0xb523952eU, 0x0b6f099fU, 0xccf5a0efU, 0x1c580662U};
+            jumpState<u32, 4>(state, Jump, nextXoshiro128);
+        }
+
+        /**
+        @brief Lanes of the kernel for whole blocks, and the engine for the rest
+        */
+        template<class Engine, class T, class Kernel, class Convert>
+        void fillXoshiro128(u32 state[4], T* out, size_t n, Kernel kernel, Convert convert)
+        {
+            const size_t blocks = n/RandomKernelLanes;
+            if(0<blocks){
+                u32 lanes[4][RandomKernelLanes];
+                u32 s[4] = {state[0], state[1], state[2], state[3]};
+                for(u32 k=0; k<RandomKernelLanes; ++k){
+                    lanes[0][k] = s[0];
+                    lanes[1][k] = s[1];
+                    lanes[2][k] = s[2];
+                    lanes[3][k] = s[3];
+                    jumpXoshiro128(s);
+                }
+                kernel(lanes, out, blocks);
+                state[0] = lanes[0][0];
+                state[1] = lanes[1][0];
+                state[2] = lanes[2][0];
+                state[3] = lanes[3][0];
+                out += blocks*RandomKernelLanes;
+            }
+            for(size_t i=blocks*RandomKernelLanes; i<n; ++i){
+                *out = convert(Engine::generate(state));
+                ++out;
+            }
         }
     }
 
@@ -233,27 +426,24 @@ namespace lcore
 
     void Xoshiro128Star::srand(u32 seed)
     {
-        state_[0] = seed;
-        for(u32 i=1; i<N; ++i){
-            state_[i] = (1812433253 * (state_[i-1]^(state_[i-1] >> 30)) + i);
+        Xoshiro128StarEngine::seedRandom(*this, seed);
+    }
+
+    void Xoshiro128Star::setState(const u32* state)
+    {
+        LASSERT(NULL != state);
+        u32 any = 0;
+        for(u32 i=0; i<N; ++i){
+            state_[i] = state[i];
+            any |= state[i];
         }
+        LASSERT(0 != any);
+        (void)any;
     }
 
     u32 Xoshiro128Star::rand()
     {
-        const u32 result = rotl(state_[0] * 5, 7) * 9;
-
-        const u32 t = state_[1] << 9;
-
-        state_[2] ^= state_[0];
-        state_[3] ^= state_[1];
-        state_[1] ^= state_[2];
-        state_[0] ^= state_[3];
-
-        state_[2] ^= t;
-
-        state_[3] = rotl(state_[3], 11);
-        return result;
+        return Xoshiro128StarEngine::generate(state_);
     }
 
     f32 Xoshiro128Star::frand()
@@ -266,6 +456,46 @@ namespace lcore
         return toF32_1(rand());
     }
 
+    f64 Xoshiro128Star::drand2()
+    {
+        const u32 high = rand();
+        return toF64(high, rand());
+    }
+
+    void Xoshiro128Star::jump()
+    {
+        jumpXoshiro128(state_);
+    }
+
+    void Xoshiro128Star::longJump()
+    {
+        longJumpXoshiro128(state_);
+    }
+
+    void Xoshiro128Star::fill(u32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillXoshiro128<Xoshiro128StarEngine>(state_, out, n, getRandomKernels().xoshiro128StarU32_, toU32);
+    }
+
+    void Xoshiro128Star::ffill(f32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillXoshiro128<Xoshiro128StarEngine>(state_, out, n, getRandomKernels().xoshiro128StarF32_0_, toF32_0);
+    }
+
+    void Xoshiro128Star::ffill2(f32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillXoshiro128<Xoshiro128StarEngine>(state_, out, n, getRandomKernels().xoshiro128StarF32_1_, toF32_1);
+    }
+
+    void Xoshiro128Star::dfill2(f64* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillPairF64(*this, out, n);
+    }
+
     //---------------------------------------------
     //---
     //--- Xoshiro128Plus
@@ -284,39 +514,160 @@ namespace lcore
 
     void Xoshiro128Plus::srand(u32 seed)
     {
-        state_[0] = seed;
-        for(u32 i=1; i<N; ++i){
-            state_[i] = (1812433253 * (state_[i-1]^(state_[i-1] >> 30)) + i);
+        Xoshiro128PlusEngine::seedRandom(*this, seed);
+    }
+
+    void Xoshiro128Plus::setState(const u32* state)
+    {
+        LASSERT(NULL != state);
+        u32 any = 0;
+        for(u32 i=0; i<N; ++i){
+            state_[i] = state[i];
+            any |= state[i];
         }
+        LASSERT(0 != any);
+        (void)any;
     }
 
     u32 Xoshiro128Plus::rand()
     {
-        const u32 result = state_[0] + state_[3];
-        const uint32_t t = state_[1] << 9;
+        return Xoshiro128PlusEngine::generate(state_);
+    }
 
-        state_[2] ^= state_[0];
-        state_[3] ^= state_[1];
-        state_[1] ^= state_[2];
-        state_[0] ^= state_[3];
+    f32 Xoshiro128Plus::frand()
+    {
+        return toF32_0(rand());
+    }
 
-        state_[2] ^= t;
+    f32 Xoshiro128Plus::frand2()
+    {
+        return toF32_1(rand());
+    }
 
-        state_[3] = rotl(state_[3], 11);
+    f64 Xoshiro128Plus::drand2()
+    {
+        const u32 high = rand();
+        return toF64(high, rand());
+    }
 
-        return result;
+    void Xoshiro128Plus::jump()
+    {
+        jumpXoshiro128(state_);
     }
 
-    f32 Xoshiro128Plus::frand()
+    void Xoshiro128Plus::longJump()
+    {
+        longJumpXoshiro128(state_);
+    }
+
+    void Xoshiro128Plus::fill(u32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillXoshiro128<Xoshiro128PlusEngine>(state_, out, n, getRandomKernels().xoshiro128PlusU32_, toU32);
+    }
+
+    void Xoshiro128Plus::ffill(f32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillXoshiro128<Xoshiro128PlusEngine>(state_, out, n, getRandomKernels().xoshiro128PlusF32_0_, toF32_0);
+    }
+
+    void Xoshiro128Plus::ffill2(f32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillXoshiro128<Xoshiro128PlusEngine>(state_, out, n, getRandomKernels().xoshiro128PlusF32_1_, toF32_1);
+    }
+
+    void Xoshiro128Plus::dfill2(f64* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillPairF64(*this, out, n);
+    }
+
+    //---------------------------------------------
+    //---
+    //--- Xoshiro128PlusPlus
+    //---
+    //---------------------------------------------
+    Xoshiro128PlusPlus::Xoshiro128PlusPlus()
+        :state_{123456789, 362436069, 521288629, 88675123}
+    {}
+
+    Xoshiro128PlusPlus::Xoshiro128PlusPlus(u32 seed)
+    {
+        srand(seed);
+    }
+
+    Xoshiro128PlusPlus::~Xoshiro128PlusPlus()
+    {}
+
+    void Xoshiro128PlusPlus::srand(u32 seed)
+    {
+        Xoshiro128PlusPlusEngine::seedRandom(*this, seed);
+    }
+
+    void Xoshiro128PlusPlus::setState(const u32* state)
+    {
+        LASSERT(NULL != state);
+        u32 any = 0;
+        for(u32 i=0; i<N; ++i){
+            state_[i] = state[i];
+            any |= state[i];
+        }
+        LASSERT(0 != any);
+        (void)any;
+    }
+
+    u32 Xoshiro128PlusPlus::rand()
+    {
+        return Xoshiro128PlusPlusEngine::generate(state_);
+    }
+
+    f32 Xoshiro128PlusPlus::frand()
     {
         return toF32_0(rand());
     }
 
-    f32 Xoshiro128Plus::frand2()
+    f32 Xoshiro128PlusPlus::frand2()
     {
         return toF32_1(rand());
     }
 
+    f64 Xoshiro128PlusPlus::drand2()
+    {
+        const u32 high = rand();
+        return toF64(high, rand());
+    }
+
+    void Xoshiro128PlusPlus::jump()
+    {
+        jumpXoshiro128(state_);
+    }
+
+    void Xoshiro128PlusPlus::longJump()
+    {
+        longJumpXoshiro128(state_);
+    }
+
+    void Xoshiro128PlusPlus::fill(u32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        u32 s[4] = {state_[0], state_[1], state_[2], state_[3]};
+        for(size_t i=0; i<n; ++i){
+            out[i] = Xoshiro128PlusPlusEngine::generate(s);
+        }
+        state_[0] = s[0];
+        state_[1] = s[1];
+        state_[2] = s[2];
+        state_[3] = s[3];
+    }
+
+    void Xoshiro128PlusPlus::dfill2(f64* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillPairF64(*this, out, n);
+    }
+
     //---------------------------------------------
     //---
     //--- Xoroshiro128Plus
@@ -336,23 +687,24 @@ namespace lcore
 
     void Xoroshiro128Plus::srand(u64 seed)
     {
-        state_[0] = seed;
-        for(u32 i=1; i<N; ++i){
-            state_[i] = (18124332531812433253ULL * (state_[i-1]^(state_[i-1] >> 60)) + i);
+        Xoroshiro128PlusEngine::seedRandom(*this, seed);
+    }
+
+    void Xoroshiro128Plus::setState(const u64* state)
+    {
+        LASSERT(NULL != state);
+        u64 any = 0;
+        for(u32 i=0; i<N; ++i){
+            state_[i] = state[i];
+            any |= state[i];
         }
+        LASSERT(0 != any);
+        (void)any;
     }
 
     u64 Xoroshiro128Plus::rand()
     {
-        const u64 s0 = state_[0];
-        u64 s1 = state_[1];
-        const u64 result = s0 + s1;
-
-        s1 ^= s0;
-        state_[0] = rotl(s0, 24) ^ s1 ^ (s1 << 16);
-        state_[1] = rotl(s1, 37);
-
-        return result;
+        return Xoroshiro128PlusEngine::generate(state_);
     }
 
     f64 Xoroshiro128Plus::drand2()
@@ -360,6 +712,18 @@ namespace lcore
         return toF64(rand());
     }
 
+    void Xoroshiro128Plus::jump()
+    {
+        static const u64 Jump[] = {0xdf900294d8f554a5ULL, 0x170865df4b3201fcULL};
+        jumpState<u64, N>(state_, Jump, nextXoroshiro128);
+    }
+
+    void Xoroshiro128Plus::longJump()
+    {
+        static const u64 Jump[] = {0xd2a98b26625eee7bULL, 0xdddf9b1090aa7ac1ULL};
+        jumpState<u64, N>(state_, Jump, nextXoroshiro128);
+    }
+
     //---------------------------------------------
     //---
     //--- Xoroshiro256Plus
@@ -379,27 +743,24 @@ namespace lcore
 
     void Xoroshiro256Plus::srand(u64 seed)
     {
-        state_[0] = seed;
-        for(u32 i=1; i<N; ++i){
-            state_[i] = (18124332531812433253ULL * (state_[i-1]^(state_[i-1] >> 60)) + i);
+        Xoroshiro256PlusEngine::seedRandom(*this, seed);
+    }
+
+    void Xoroshiro256Plus::setState(const u64* state)
+    {
+        LASSERT(NULL != state);
+        u64 any = 0;
+        for(u32 i=0; i<N; ++i){
+            state_[i] = state[i];
+            any |= state[i];
         }
+        LASSERT(0 != any);
+        (void)any;
     }
 
     u64 Xoroshiro256Plus::rand()
     {
-        const u64 result = state_[0] + state_[3];
-        const u64 t = state_[1] << 17;
-
-        state_[2] ^= state_[0];
-        state_[3] ^= state_[1];
-        state_[1] ^= state_[2];
-        state_[0] ^= state_[3];
-
-        state_[2] ^= t;
-
-        state_[3] = rotl(state_[3], 45);
-
-        return result;
+        return Xoroshiro256PlusEngine::generate(state_);
     }
 
     f64 Xoroshiro256Plus::drand2()
@@ -407,6 +768,18 @@ namespace lcore
         return toF64(rand());
     }
 
+    void Xoroshiro256Plus::jump()
+    {
+        static const u64 Jump[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        jumpState<u64, N>(state_, Jump, nextXoshiro256);
+    }
+
+    void Xoroshiro256Plus::longJump()
+    {
+        static const u64 Jump[] = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+        jumpState<u64, N>(state_, Jump, nextXoshiro256);
+    }
+
     //---------------------------------------------
     //---
     //--- Xoroshiro512Plus
@@ -427,35 +800,327 @@ namespace lcore
 
     void Xoroshiro512Plus::srand(u64 seed)
     {
-        state_[0] = seed;
-        for(u32 i=1; i<N; ++i){
-            state_[i] = (18124332531812433253ULL * (state_[i-1]^(state_[i-1] >> 60)) + i);
+        Xoroshiro512PlusEngine::seedRandom(*this, seed);
+    }
+
+    void Xoroshiro512Plus::setState(const u64* state)
+    {
+        LASSERT(NULL != state);
+        u64 any = 0;
+        for(u32 i=0; i<N; ++i){
+            state_[i] = state[i];
+            any |= state[i];
         }
+        LASSERT(0 != any);
+        (void)any;
     }
 
     u64 Xoroshiro512Plus::rand()
     {
-        const u64 result = state_[0] + state_[2];
+        return Xoroshiro512PlusEngine::generate(state_);
+    }
 
-        const u64 t = state_[1] << 11;
+    f64 Xoroshiro512Plus::drand2()
+    {
+        return toF64(rand());
+    }
 
-        state_[2] ^= state_[0];
-        state_[5] ^= state_[1];
-        state_[1] ^= state_[2];
-        state_[7] ^= state_[3];
-        state_[3] ^= state_[4];
-        state_[4] ^= state_[5];
-        state_[0] ^= state_[6];
-        state_[6] ^= state_[7];
+    void Xoroshiro512Plus::jump()
+    {
+        static const u64 Jump[] = {
+            0x33ed89b6e7a353f9ULL, 0x760083d7955323beULL, 0x2837f2fbb5f22faeULL, 0x4b8c5674d309511cULL,
+            0xb11ac47a7ba28c25ULL, 0xf1be7667092bcc1cULL, 0x53851efdb6df0aafULL, 0x1ebbc8b23eaf25dbULL};
+        jumpState<u64, N>(state_, Jump, nextXoshiro512);
+    }
 
-        state_[6] ^= t;
+    void Xoroshiro512Plus::longJump()
+    {
+        static const u64 Jump[] = {
+            0x11467fef8f921d28ULL, 0xa2a819f2e79c8ea8ULL, 0xa8299fc284b3959aULL, 0xb4d347340ca63ee1ULL,
+            0x1cb0940bedbff6ceULL, 0xd956c5c4fa1f8e17ULL, 0x915e38fd4eda93bcULL, 0x5b3ccdfa5d7daca5ULL};
+        jumpState<u64, N>(state_, Jump, nextXoshiro512);
+    }
 
-        state_[7] = rotl(state_[7], 21);
+    //---------------------------------------------
+    //---
+    //--- Xoshiro256StarStar
+    //---
+    //---------------------------------------------
+    Xoshiro256StarStar::Xoshiro256StarStar()
+        :state_{123456789123456789, 362436069362436069, 521288629521288629, 8867512388675123}
+    {}
+
+    Xoshiro256StarStar::Xoshiro256StarStar(u64 seed)
+    {
+        srand(seed);
+    }
+
+    Xoshiro256StarStar::~Xoshiro256StarStar()
+    {}
+
+    void Xoshiro256StarStar::srand(u64 seed)
+    {
+        Xoshiro256StarStarEngine::seedRandom(*this, seed);
+    }
+
+    void Xoshiro256StarStar::setState(const u64* state)
+    {
+        LASSERT(NULL != state);
+        u64 any = 0;
+        for(u32 i=0; i<N; ++i){
+            state_[i] = state[i];
+            any |= state[i];
+        }
+        LASSERT(0 != any);
+        (void)any;
+    }
+
+    u64 Xoshiro256StarStar::rand()
+    {
+        return Xoshiro256StarStarEngine::generate(state_);
+    }
+
+    f64 Xoshiro256StarStar::drand2()
+    {
+        return toF64(rand());
+    }
+
+    void Xoshiro256StarStar::jump()
+    {
+        static const u64 Jump[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        jumpState<u64, N>(state_, Jump, nextXoshiro256);
+    }
+
+    void Xoshiro256StarStar::longJump()
+    {
+        static const u64 Jump[] = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+        jumpState<u64, N>(state_, Jump, nextXoshiro256);
+    }
+
+    //---------------------------------------------
+    //---
+    //--- PCG64DXSM
+    //---
+    //---------------------------------------------
+    namespace
+    {
+        static const u64 PCGCheapMultiplier = 0xda942042e4dd58b5ULL;
+
+        /**
+        @brief Lower 128 bits of x*y
+        */
+        inline void mul128(u64& low, u64& high, u64 xLow, u64 xHigh, u64 yLow, u64 yHigh)
+        {
+            high = mul64(xLow, yLow, low) + xLow*yHigh + xHigh*yLow;
+        }
+
+        inline void add128(u64& low, u64& high, u64 yLow, u64 yHigh)
+        {
+            low += yLow;
+            high += yHigh + ((low<yLow)? 1 : 0);
+        }
+    }
+
+    PCG64DXSM::PCG64DXSM()
+        :low_(0x7d3e9cb6cfe0549bULL)
+        ,high_(0x979c9a98d8462005ULL)
+        ,incLow_(0xda3e39cb94b95bdbULL)
+        ,incHigh_(0x0000000000000001ULL)
+    {}
+
+    PCG64DXSM::PCG64DXSM(u64 seed)
+    {
+        srand(seed);
+    }
+
+    PCG64DXSM::~PCG64DXSM()
+    {}
+
+    void PCG64DXSM::srand(u64 seed)
+    {
+        //As pcg_setseq_128_srandom_r of the reference
+        SplitMix64 splitMix(seed);
+        const u64 stateLow = splitMix.rand();
+        const u64 stateHigh = splitMix.rand();
+        const u64 sequenceLow = splitMix.rand();
+        const u64 sequenceHigh = splitMix.rand();
+        incLow_ = (sequenceLow<<1) | 1;
+        incHigh_ = (sequenceHigh<<1) | (sequenceLow>>63);
+        low_ = high_ = 0;
+        step();
+        add128(low_, high_, stateLow, stateHigh);
+        step();
+    }
+
+    void PCG64DXSM::setState(const u64* state)
+    {
+        LASSERT(NULL != state);
+        low_ = state[0];
+        high_ = state[1];
+        incLow_ = state[2] | 1;
+        incHigh_ = state[3];
+    }
+
+    u64 PCG64DXSM::rand()
+    {
+        //DXSM of the state before the step
+        u64 hi = high_;
+        const u64 lo = low_ | 1;
+        hi ^= hi >> 32;
+        hi *= PCGCheapMultiplier;
+        hi ^= hi >> 48;
+        hi *= lo;
+        step();
+        return hi;
+    }
 
+    f64 PCG64DXSM::drand2()
+    {
+        return toF64(rand());
+    }
+
+    void PCG64DXSM::discard(u64 delta)
+    {
+        advance(delta, 0);
+    }
+
+    void PCG64DXSM::jump()
+    {
+        advance(0, 1);
+    }
+
+    void PCG64DXSM::longJump()
+    {
+        advance(0, 1ULL<<32);
+    }
+
+    void PCG64DXSM::step()
+    {
+        high_ = mul64(low_, PCGCheapMultiplier, low_) + high_*PCGCheapMultiplier;
+        add128(low_, high_, incLow_, incHigh_);
+    }
+
+    void PCG64DXSM::advance(u64 deltaLow, u64 deltaHigh)
+    {
+        //Brown's jump ahead of LCGs, the step of 2^i is a multiplier and an increment
+        u64 accMulLow = 1, accMulHigh = 0;
+        u64 accPlusLow = 0, accPlusHigh = 0;
+        u64 mulLow = PCGCheapMultiplier, mulHigh = 0;
+        u64 plusLow = incLow_, plusHigh = incHigh_;
+        while(0 != (deltaLow|deltaHigh)){
+            if(deltaLow & 1){
+                mul128(accMulLow, accMulHigh, accMulLow, accMulHigh, mulLow, mulHigh);
+                mul128(accPlusLow, accPlusHigh, accPlusLow, accPlusHigh, mulLow, mulHigh);
+                add128(accPlusLow, accPlusHigh, plusLow, plusHigh);
+            }
+            u64 mulPlusOneLow = mulLow, mulPlusOneHigh = mulHigh;
+            add128(mulPlusOneLow, mulPlusOneHigh, 1, 0);
+            mul128(plusLow, plusHigh, plusLow, plusHigh, mulPlusOneLow, mulPlusOneHigh);
+            mul128(mulLow, mulHigh, mulLow, mulHigh, mulLow, mulHigh);
+            deltaLow = (deltaLow>>1) | (deltaHigh<<63);
+            deltaHigh >>= 1;
+        }
+        mul128(low_, high_, low_, high_, accMulLow, accMulHigh);
+        add128(low_, high_, accPlusLow, accPlusHigh);
+    }
+
+    //---------------------------------------------
+    //---
+    //--- SFC64
+    //---
+    //---------------------------------------------
+    SFC64::SFC64()
+    {
+        srand(0);
+    }
+
+    SFC64::SFC64(u64 seed)
+    {
+        srand(seed);
+    }
+
+    SFC64::~SFC64()
+    {}
+
+    void SFC64::srand(u64 seed)
+    {
+        a_ = b_ = c_ = seed;
+        counter_ = 1;
+        for(u32 i=0; i<12; ++i){
+            rand();
+        }
+    }
+
+    void SFC64::setState(const u64* state)
+    {
+        LASSERT(NULL != state);
+        a_ = state[0];
+        b_ = state[1];
+        c_ = state[2];
+        counter_ = state[3];
+    }
+
+    u64 SFC64::rand()
+    {
+        const u64 result = a_ + b_ + counter_++;
+        a_ = b_ ^ (b_ >> 11);
+        b_ = c_ + (c_ << 3);
+        c_ = rotl(c_, 24) + result;
         return result;
     }
 
-    f64 Xoroshiro512Plus::drand2()
+    f64 SFC64::drand2()
+    {
+        return toF64(rand());
+    }
+
+    //---------------------------------------------
+    //---
+    //--- RomuTrio
+    //---
+    //---------------------------------------------
+    RomuTrio::RomuTrio()
+    {
+        srand(0);
+    }
+
+    RomuTrio::RomuTrio(u64 seed)
+    {
+        srand(seed);
+    }
+
+    RomuTrio::~RomuTrio()
+    {}
+
+    void RomuTrio::srand(u64 seed)
+    {
+        SplitMix64 splitMix(seed);
+        x_ = splitMix.rand();
+        y_ = splitMix.rand();
+        z_ = splitMix.rand();
+    }
+
+    void RomuTrio::setState(const u64* state)
+    {
+        LASSERT(NULL != state);
+        x_ = state[0];
+        y_ = state[1];
+        z_ = state[2];
+        LASSERT(0 != (x_|y_|z_));
+    }
+
+    u64 RomuTrio::rand()
+    {
+        const u64 xp = x_;
+        const u64 yp = y_;
+        const u64 zp = z_;
+        x_ = 15241094284759029579ULL * zp;
+        y_ = rotl(yp - xp, 12);
+        z_ = rotl(zp - yp, 44);
+        return xp;
+    }
+
+    f64 RomuTrio::drand2()
     {
         return toF64(rand());
     }
@@ -466,12 +1131,12 @@ namespace lcore
     //---
     //---------------------------------------------
     RandWELL::RandWELL()
-        :index_(0)
+        :index_(N)
     {
     }
 
     RandWELL::RandWELL(u32 seed)
-        :index_(0)
+        :index_(N)
     {
         srand(seed);
     }
@@ -486,23 +1151,29 @@ namespace lcore
         for(u32 i=1; i<N; ++i){
             state_[i] = (1812433253 * (state_[i-1]^(state_[i-1] >> 30)) + i); 
         }
+        index_ = N;
     }
 
-    u32 RandWELL::rand()
+    void RandWELL::setState(const u32* state)
     {
-        u32 a, b, c, d;
+        LASSERT(NULL != state);
+        u32 any = 0;
+        for(u32 i=0; i<N; ++i){
+            state_[i] = state[i];
+            any |= state[i];
+        }
+        LASSERT(0 != any);
+        (void)any;
+        index_ = N;
+    }
 
-        a = state_[index_];
-        c = state_[(index_+13)&15];
-        b = a^c^(a<<16)^(c<<15);
-        c = state_[(index_+9)&15];
-        c ^= c>>11;
-        a = state_[index_] = b^c;
-        d = a^((a<<5)&0xDA442D24UL);
-        index_ = (index_ + 15) & 15;
-        a = state_[index_];
-        state_[index_] = a^b^d^(a<<2)^(b<<18)^(c<<28);
-        return state_[index_];
+    u32 RandWELL::rand()
+    {
+        if(N<=index_){
+            generate(buffer_);
+            index_ = 0;
+        }
+        return buffer_[index_++];
     }
 
     f32 RandWELL::frand()
@@ -515,41 +1186,363 @@ namespace lcore
         return toF32_1(rand());
     }
 
-    //---------------------------------------------
-    void cryptRandom(u32 size, void* buffer)
-    {
-        LASSERT(NULL != buffer);
-#if _WIN32
-        HMODULE handle = LoadLibrary("Advapi32.dll");
-        if(NULL != handle){
-            FARPROC procAddress = GetProcAddress(handle, "SystemFunction036");
-            BOOLEAN result = (*(BOOLEAN (*)(PVOID, ULONG))procAddress)(buffer, size);
-            FreeLibrary(handle);
-            if(result){
+    f64 RandWELL::drand2()
+    {
+        const u32 high = rand();
+        return toF64(high, rand());
+    }
+
+    void RandWELL::fill(u32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        for(; index_<N && 0<n; --n){
+            *out = buffer_[index_++];
+            ++out;
+        }
+        for(; N<=n; n-=N){
+            generate(out);
+            out += N;
+        }
+        if(0<n){
+            generate(buffer_);
+            for(index_=0; index_<n; ++index_){
+                out[index_] = buffer_[index_];
+            }
+        }
+    }
+
+    void RandWELL::ffill(f32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        static const u32 BlockSize = 64*N;
+        const RandomKernels::ConvertF32 convert = getRandomKernels().toF32_0_;
+        u32 block[BlockSize];
+        while(0<n){
+            u32 count = (BlockSize<n)? BlockSize : static_cast<u32>(n);
+            fill(block, count);
+            convert(out, block, count);
+            out += count;
+            n -= count;
+        }
+    }
+
+    void RandWELL::ffill2(f32* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        static const u32 BlockSize = 64*N;
+        const RandomKernels::ConvertF32 convert = getRandomKernels().toF32_1_;
+        u32 block[BlockSize];
+        while(0<n){
+            u32 count = (BlockSize<n)? BlockSize : static_cast<u32>(n);
+            fill(block, count);
+            convert(out, block, count);
+            out += count;
+            n -= count;
+        }
+    }
+
+    void RandWELL::dfill2(f64* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        fillPairF64(*this, out, n);
+    }
+
+    namespace
+    {
+        /**
+        @brief One WELL512 step at a constant ring position I, writes the output to out[(16-I)&15]
+        */
+        template<u32 I>
+        inline void stepWELL512(u32 state[16], u32* out)
+        {
+            static const u32 P = (I+15)&15;
+            u32 a, b, c, d;
+
+            a = state[I];
+            c = state[(I+13)&15];
+            b = a^c^(a<<16)^(c<<15);
+            c = state[(I+9)&15];
+            c ^= c>>11;
+            a = state[I] = b^c;
+            d = a^((a<<5)&0xDA442D24UL);
+            a = state[P];
+            state[P] = a^b^d^(a<<2)^(b<<18)^(c<<28);
+            out[(16-I)&15] = state[P];
+        }
+    }
+
+    namespace
+    {
+        /**
+        @brief Polynomial over GF(2) of degree less than 512, bit i is the coefficient of x^i
+        */
+        struct PolyWELL512
+        {
+            static const u32 Words = 8;
+            u64 w_[Words];
+        };
+
+        // Characteristic polynomial of the WELL512 transition, x^512 + CharPoly
+        static const u64 CharPolyWELL512[PolyWELL512::Words] =
+        {
+            0xe0f4f3e2a7600001ULL, 0x7d6b79a9cb30e185ULL, 0x13a524cbf3d46237ULL, 0xa1381bcb38e3c2d2ULL,
+            0x04a72cdaf7ab5f06ULL, 0xaca072f14e302521ULL, 0x24aa25c94dd96181ULL, 0x0000000003c417e7ULL,
+        };
+
+        // a*b mod CharPoly
+        PolyWELL512 mulmod(const PolyWELL512& a, const PolyWELL512& b)
+        {
+            static const u32 Words = PolyWELL512::Words;
+            u64 product[Words*2] = {};
+            for(u32 i=0; i<Words; ++i){
+                for(u32 bit=0; bit<64; ++bit){
+                    if(0 == (a.w_[i] & (1ULL<<bit))){
+                        continue;
+                    }
+                    //product ^= b << (64*i+bit)
+                    for(u32 j=0; j<Words; ++j){
+                        product[i+j] ^= b.w_[j] << bit;
+                        if(0<bit){
+                            product[i+j+1] ^= b.w_[j] >> (64-bit);
+                        }
+                    }
+                }
+            }
+
+            //x^512 = CharPoly, reduce from the top
+            for(u32 i=Words*2*64-1; Words*64<=i; --i){
+                if(0 == (product[i>>6] & (1ULL<<(i&63)))){
+                    continue;
+                }
+                product[i>>6] ^= 1ULL<<(i&63);
+                const u32 shift = i - Words*64;
+                const u32 word = shift>>6;
+                const u32 bit = shift&63;
+                for(u32 j=0; j<Words; ++j){
+                    product[word+j] ^= CharPolyWELL512[j] << bit;
+                    if(0<bit){
+                        product[word+j+1] ^= CharPolyWELL512[j] >> (64-bit);
+                    }
+                }
+            }
+
+            PolyWELL512 result;
+            for(u32 i=0; i<Words; ++i){
+                result.w_[i] = product[i];
+            }
+            return result;
+        }
+
+        /**
+        @brief x^(2^i) mod CharPoly for i in [0, 64)
+        */
+        struct JumpTableWELL512
+        {
+            static const u32 Size = 64;
+
+            JumpTableWELL512()
+            {
+                PolyWELL512 x = {};
+                x.w_[0] = 2;
+                table_[0] = x;
+                for(u32 i=1; i<Size; ++i){
+                    table_[i] = mulmod(table_[i-1], table_[i-1]);
+                }
+            }
+
+            PolyWELL512 table_[Size];
+        };
+
+        const JumpTableWELL512& getJumpTableWELL512()
+        {
+            static const JumpTableWELL512 table;
+            return table;
+        }
+
+        inline void stepWELL512(u32 state[16], u32& index)
+        {
+            u32 a, b, c, d;
+
+            a = state[index];
+            c = state[(index+13)&15];
+            b = a^c^(a<<16)^(c<<15);
+            c = state[(index+9)&15];
+            c ^= c>>11;
+            a = state[index] = b^c;
+            d = a^((a<<5)&0xDA442D24UL);
+            index = (index + 15) & 15;
+            a = state[index];
+            state[index] = a^b^d^(a<<2)^(b<<18)^(c<<28);
+        }
+
+        /**
+        @brief Advance a state at ring position 0 by steps
+        */
+        void jumpWELL512(u32 state[16], u64 steps)
+        {
+            if(steps<=0){
                 return;
             }
+            const JumpTableWELL512& table = getJumpTableWELL512();
+            PolyWELL512 poly = {};
+            poly.w_[0] = 1;
+            for(u32 i=0; i<JumpTableWELL512::Size; ++i){
+                if(steps & (1ULL<<i)){
+                    poly = mulmod(poly, table.table_[i]);
+                }
+            }
+
+            //state = sum of poly's coefficient * (state after i steps), relative to the ring position
+            u32 s[16];
+            u32 index = 0;
+            u32 result[16] = {};
+            for(u32 i=0; i<16; ++i){
+                s[i] = state[i];
+            }
+            for(u32 i=0; i<PolyWELL512::Words*64; ++i){
+                if(poly.w_[i>>6] & (1ULL<<(i&63))){
+                    for(u32 j=0; j<16; ++j){
+                        result[j] ^= s[(index+j)&15];
+                    }
+                }
+                stepWELL512(s, index);
+            }
+            for(u32 i=0; i<16; ++i){
+                state[i] = result[i];
+            }
         }
+    }
 
-        RandWELL random(lcore::getDefaultSeed());
-        u32 count = size/sizeof(u32);
-        u32* pu32 = static_cast<u32*>(buffer);
-        for(u32 i=0; i<count; ++i){
-            *pu32 = random.rand();
-            ++pu32;
+    void RandWELL::discard(u64 n)
+    {
+        if(index_<N){
+            u64 buffered = N - index_;
+            if(n<=buffered){
+                index_ += static_cast<u32>(n);
+                return;
+            }
+            n -= buffered;
+            index_ = N;
         }
-        count = size - count*sizeof(u32);
-        u8* pu8 = reinterpret_cast<u8*>(pu32);
-        for(u32 i=0; i<count; ++i){
-            *pu8 = static_cast<u8>(random.rand());
-            ++pu8;
+        //Keep the state at ring position 0 by jumping whole blocks
+        jumpWELL512(state_, n - n%N);
+        n %= N;
+        if(0<n){
+            generate(buffer_);
+            index_ = static_cast<u32>(n);
         }
-#else
-        s32 fd = open("/dev/random", O_RDONLY);
-        if(fd<0){
-            return;
+    }
+
+    void RandWELL::generate(u32* out)
+    {
+        //The ring position returns to 0 after N steps, so every index is a constant.
+        stepWELL512<0>(state_, out);
+        stepWELL512<15>(state_, out);
+        stepWELL512<14>(state_, out);
+        stepWELL512<13>(state_, out);
+        stepWELL512<12>(state_, out);
+        stepWELL512<11>(state_, out);
+        stepWELL512<10>(state_, out);
+        stepWELL512<9>(state_, out);
+        stepWELL512<8>(state_, out);
+        stepWELL512<7>(state_, out);
+        stepWELL512<6>(state_, out);
+        stepWELL512<5>(state_, out);
+        stepWELL512<4>(state_, out);
+        stepWELL512<3>(state_, out);
+        stepWELL512<2>(state_, out);
+        stepWELL512<1>(state_, out);
+    }
+
+    //---------------------------------------------
+    //---
+    //--- SplitMix64
+    //---
+    //---------------------------------------------
+    void SplitMix64::fill(u64* out, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        getRandomKernels().splitMix64_(out, state_, n);
+        state_ += n*Gamma;
+    }
+
+    //---------------------------------------------
+    //---
+    //--- Bounded values
+    //---
+    //---------------------------------------------
+    bool mulHighU32(u32* values, const u32* bits, size_t n, u32 range, u32 threshold)
+    {
+        LASSERT((NULL != values && NULL != bits) || 0 == n);
+        return 0 != getRandomKernels().mulHighU32_(values, bits, n, range, threshold);
+    }
+
+    //---------------------------------------------
+    //---
+    //--- Conversions
+    //---
+    //---------------------------------------------
+    void convertF32(f32* out, const u32* in, size_t n, RandomInterval interval, RandomPrecision precision)
+    {
+        LASSERT((NULL != out && NULL != in) || 0 == n);
+        const RandomKernels& kernels = getRandomKernels();
+        RandomKernels::ConvertF32 convert;
+        if(RandomPrecision_Full == precision){
+            convert = (RandomInterval_OpenClosed == interval)? kernels.toF32Full_0_ : kernels.toF32Full_1_;
+        }else{
+            convert = (RandomInterval_OpenClosed == interval)? kernels.toF32_0_ : kernels.toF32_1_;
+        }
+        convert(out, in, n);
+    }
+
+    void convertF64(f64* out, const u64* in, size_t n, RandomInterval interval, RandomPrecision precision)
+    {
+        LASSERT((NULL != out && NULL != in) || 0 == n);
+        const RandomKernels& kernels = getRandomKernels();
+        RandomKernels::ConvertF64 convert;
+        if(RandomPrecision_Full == precision){
+            convert = (RandomInterval_OpenClosed == interval)? kernels.toF64Full_0_ : kernels.toF64Full_1_;
+        }else{
+            convert = (RandomInterval_OpenClosed == interval)? kernels.toF64_0_ : kernels.toF64_1_;
+        }
+        convert(out, in, n);
+    }
+
+    void convertF64(f64* out, const u32* in, size_t n, RandomInterval interval, RandomPrecision precision)
+    {
+        LASSERT((NULL != out && NULL != in) || 0 == n);
+        const RandomKernels& kernels = getRandomKernels();
+        RandomKernels::ConvertPairF64 convert;
+        if(RandomPrecision_Full == precision){
+            convert = (RandomInterval_OpenClosed == interval)? kernels.pairToF64Full_0_ : kernels.pairToF64Full_1_;
+        }else{
+            convert = (RandomInterval_OpenClosed == interval)? kernels.pairToF64_0_ : kernels.pairToF64_1_;
+        }
+        convert(out, in, n);
+    }
+
+    void convertF32(f32* out, const u32* in, size_t n, f32 vmin, f32 vmax)
+    {
+        LASSERT(vmin<vmax);
+        convertF32(out, in, n, RandomInterval_ClosedOpen, RandomPrecision_Full);
+        //Rounding of vmin + range*u can reach vmax
+        const f32 range = vmax - vmin;
+        const f32 upper = std::nextafter(vmax, vmin);
+        for(size_t i=0; i<n; ++i){
+            const f32 x = vmin + range*out[i];
+            out[i] = (x<upper)? x : upper;
+        }
+    }
+
+    void convertF64(f64* out, const u64* in, size_t n, f64 vmin, f64 vmax)
+    {
+        LASSERT(vmin<vmax);
+        convertF64(out, in, n, RandomInterval_ClosedOpen, RandomPrecision_Full);
+        const f64 range = vmax - vmin;
+        const f64 upper = std::nextafter(vmax, vmin);
+        for(size_t i=0; i<n; ++i){
+            const f64 x = vmin + range*out[i];
+            out[i] = (x<upper)? x : upper;
         }
-        read(fd, buffer, size);
-        close(fd);
-#endif
     }
 }
@@ -10,8 +10,13 @@
 #include <cstdint>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <ctime>
 #include <utility>
+#include <type_traits>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 #define LASSERT(exp) assert(exp)
 #else
 #include "lcore.h"
@@ -62,10 +67,30 @@ namespace lcore
     u64 scramble(u64 v, u64 i);
 
     u32 getStaticSeed();
+
+    /**
+    @brief A different seed for each call, from system entropy read once and the time stamp counter
+    */
     u32 getDefaultSeed();
     u64 getStaticSeed64();
+
+    /**
+    @brief A different seed for each call, from system entropy read once and the time stamp counter
+    */
     u64 getDefaultSeed64();
 
+    enum RandomInterval
+    {
+        RandomInterval_OpenClosed = 0, //!< (0, 1], as frand
+        RandomInterval_ClosedOpen, //!< [0, 1), as frand2
+    };
+
+    enum RandomPrecision
+    {
+        RandomPrecision_Fast = 0, //!< Random mantissa under a fixed exponent, 23 bits for f32 and 52 bits for f64
+        RandomPrecision_Full, //!< Multiples of 2^-24 for f32 and 2^-53 for f64
+    };
+
     //---------------------------------------------
     //---
     //--- Xoshiro128Star
@@ -84,6 +109,11 @@ namespace lcore
         */
         void srand(u32 seed);
 
+        /**
+        @brief Set the state words, which should not be all zero
+        */
+        void setState(const u32* state);
+
         /**
         @brief Generate a unsigned number in [0 0xFFFFFFFFU]
         */
@@ -98,8 +128,56 @@ namespace lcore
         @brief Generate a float in [0, 1)
         */
         f32 frand2();
+
+        /**
+        @brief Generate a double in [0, 1) of 53 bits from two outputs
+        */
+        f64 drand2();
+
+        /**
+        @brief Advance 2^64 steps, same as 2^64 calls of rand()
+        */
+        void jump();
+
+        /**
+        @brief Advance 2^96 steps, same as 2^96 calls of rand()
+        */
+        void longJump();
+
+        /**
+        @brief Fill a buffer with unsigned numbers in [0 0xFFFFFFFFU]
+        @param out
+        @param n
+
+        The first n - n%FillLanes values come from FillLanes interleaved streams.
+        Lane k is this generator advanced by k*2^64 steps, lane 0 is this generator itself,
+        and out[FillLanes*j + k] is the j-th output of lane k.
+        The streams of StreamFactory are FillLanes jumps apart, so no lane reaches another stream.
+        The last n%FillLanes values continue lane 0 by rand().
+        On return, this generator holds the state of lane 0,
+        so calls with multiples of FillLanes concatenate into one stream.
+        */
+        void fill(u32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with floats in (0, 1], in the same order as fill
+        */
+        void ffill(f32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with floats in [0, 1), in the same order as fill
+        */
+        void ffill2(f32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with doubles in [0, 1) of 53 bits, from 2n outputs of fill, the first of a pair is the upper half
+        */
+        void dfill2(f64* out, size_t n);
+
+        static const u32 FillLanes = 16;
+        static const u32 StateSize = 4; //!< Words of setState
     private:
-        static const u32 N = 4;
+        static const u32 N = StateSize;
         u32 state_[N];
     };
 
@@ -121,6 +199,11 @@ namespace lcore
         */
         void srand(u32 seed);
 
+        /**
+        @brief Set the state words, which should not be all zero
+        */
+        void setState(const u32* state);
+
         /**
         @brief Generate a unsigned number in [0 0xFFFFFFFFU]
         */
@@ -135,8 +218,128 @@ namespace lcore
         @brief Generate a float in [0, 1)
         */
         f32 frand2();
+
+        /**
+        @brief Generate a double in [0, 1) of 53 bits from two outputs
+        */
+        f64 drand2();
+
+        /**
+        @brief Advance 2^64 steps, same as 2^64 calls of rand()
+        */
+        void jump();
+
+        /**
+        @brief Advance 2^96 steps, same as 2^96 calls of rand()
+        */
+        void longJump();
+
+        /**
+        @brief Fill a buffer with unsigned numbers in [0 0xFFFFFFFFU]
+        @param out
+        @param n
+
+        The first n - n%FillLanes values come from FillLanes interleaved streams.
+        Lane k is this generator advanced by k*2^64 steps, lane 0 is this generator itself,
+        and out[FillLanes*j + k] is the j-th output of lane k.
+        The streams of StreamFactory are FillLanes jumps apart, so no lane reaches another stream.
+        The last n%FillLanes values continue lane 0 by rand().
+        On return, this generator holds the state of lane 0,
+        so calls with multiples of FillLanes concatenate into one stream.
+        */
+        void fill(u32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with floats in (0, 1], in the same order as fill
+        */
+        void ffill(f32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with floats in [0, 1), in the same order as fill
+        */
+        void ffill2(f32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with doubles in [0, 1) of 53 bits, from 2n outputs of fill, the first of a pair is the upper half
+        */
+        void dfill2(f64* out, size_t n);
+
+        static const u32 FillLanes = 16;
+        static const u32 StateSize = 4; //!< Words of setState
     private:
-        static const u32 N = 4;
+        static const u32 N = StateSize;
+        u32 state_[N];
+    };
+
+    //---------------------------------------------
+    //---
+    //--- Xoshiro128++
+    //---
+    //---------------------------------------------
+    /**
+    @brief The linear engine of Xoshiro128Plus with the ++ scrambler, whose low bits pass the tests as well as the high bits
+    */
+    class Xoshiro128PlusPlus
+    {
+    public:
+        Xoshiro128PlusPlus();
+        explicit Xoshiro128PlusPlus(u32 seed);
+        ~Xoshiro128PlusPlus();
+
+        /**
+        @brief Initialize with a seed, the state is the SplitMix64 outputs from the seed as seedSplitMix64
+        @param seed
+        */
+        void srand(u32 seed);
+
+        /**
+        @brief Set the state words, which should not be all zero
+        */
+        void setState(const u32* state);
+
+        /**
+        @brief Generate a unsigned number in [0 0xFFFFFFFFU]
+        */
+        u32 rand();
+
+        /**
+        @brief Generate a float in (0, 1]
+        */
+        f32 frand();
+
+        /**
+        @brief Generate a float in [0, 1)
+        */
+        f32 frand2();
+
+        /**
+        @brief Generate a double in [0, 1) of 53 bits from two outputs
+        */
+        f64 drand2();
+
+        /**
+        @brief Advance 2^64 steps, same as 2^64 calls of rand()
+        */
+        void jump();
+
+        /**
+        @brief Advance 2^96 steps, same as 2^96 calls of rand()
+        */
+        void longJump();
+
+        /**
+        @brief Same as n calls of rand()
+        */
+        void fill(u32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with doubles in [0, 1) of 53 bits, from 2n outputs of fill, the first of a pair is the upper half
+        */
+        void dfill2(f64* out, size_t n);
+
+        static const u32 StateSize = 4; //!< Words of setState
+    private:
+        static const u32 N = StateSize;
         u32 state_[N];
     };
 
@@ -158,6 +361,11 @@ namespace lcore
         */
         void srand(u64 seed);
 
+        /**
+        @brief Set the state words, which should not be all zero
+        */
+        void setState(const u64* state);
+
         /**
         @brief Generate a unsigned number in [0 0xFFFF FFFF FFFF FFFFU]
         */
@@ -167,8 +375,20 @@ namespace lcore
         @brief Generate a double in [0, 1)
         */
         f64 drand2();
+
+        /**
+        @brief Advance 2^64 steps, same as 2^64 calls of rand()
+        */
+        void jump();
+
+        /**
+        @brief Advance 2^96 steps, same as 2^96 calls of rand()
+        */
+        void longJump();
+
+        static const u32 StateSize = 2; //!< Words of setState
     private:
-        static const u32 N = 2;
+        static const u32 N = StateSize;
         u64 state_[N];
     };
 
@@ -190,6 +410,11 @@ namespace lcore
         */
         void srand(u64 seed);
 
+        /**
+        @brief Set the state words, which should not be all zero
+        */
+        void setState(const u64* state);
+
         /**
         @brief Generate a unsigned number in [0 0xFFFF FFFF FFFF FFFFU]
         */
@@ -199,8 +424,20 @@ namespace lcore
         @brief Generate a double in [0, 1)
         */
         f64 drand2();
+
+        /**
+        @brief Advance 2^128 steps, same as 2^128 calls of rand()
+        */
+        void jump();
+
+        /**
+        @brief Advance 2^192 steps, same as 2^192 calls of rand()
+        */
+        void longJump();
+
+        static const u32 StateSize = 4; //!< Words of setState
     private:
-        static const u32 N = 4;
+        static const u32 N = StateSize;
         u64 state_[N];
     };
 
@@ -222,6 +459,63 @@ namespace lcore
         */
         void srand(u64 seed);
 
+        /**
+        @brief Set the state words, which should not be all zero
+        */
+        void setState(const u64* state);
+
+        /**
+        @brief Generate a unsigned number in [0 0xFFFF FFFF FFFF FFFFU]
+        */
+        u64 rand();
+
+        /**
+        @brief Generate a double in [0, 1)
+        */
+        f64 drand2();
+
+        /**
+        @brief Advance 2^256 steps, same as 2^256 calls of rand()
+        */
+        void jump();
+
+        /**
+        @brief Advance 2^384 steps, same as 2^384 calls of rand()
+        */
+        void longJump();
+
+        static const u32 StateSize = 8; //!< Words of setState
+    private:
+        static const u32 N = StateSize;
+        u64 state_[N];
+    };
+
+    //---------------------------------------------
+    //---
+    //--- Xoshiro256**
+    //---
+    //---------------------------------------------
+    /**
+    @brief The linear engine of Xoroshiro256Plus with the ** scrambler, all 64 bits of which pass the tests
+    */
+    class Xoshiro256StarStar
+    {
+    public:
+        Xoshiro256StarStar();
+        explicit Xoshiro256StarStar(u64 seed);
+        ~Xoshiro256StarStar();
+
+        /**
+        @brief Initialize with a seed, the state is the SplitMix64 outputs from the seed as seedSplitMix64
+        @param seed
+        */
+        void srand(u64 seed);
+
+        /**
+        @brief Set the state words, which should not be all zero
+        */
+        void setState(const u64* state);
+
         /**
         @brief Generate a unsigned number in [0 0xFFFF FFFF FFFF FFFFU]
         */
@@ -231,11 +525,172 @@ namespace lcore
         @brief Generate a double in [0, 1)
         */
         f64 drand2();
+
+        /**
+        @brief Advance 2^128 steps, same as 2^128 calls of rand()
+        */
+        void jump();
+
+        /**
+        @brief Advance 2^192 steps, same as 2^192 calls of rand()
+        */
+        void longJump();
+
+        static const u32 StateSize = 4; //!< Words of setState
     private:
-        static const u32 N = 8;
+        static const u32 N = StateSize;
         u64 state_[N];
     };
 
+    //---------------------------------------------
+    //---
+    //--- PCG64-DXSM
+    //---
+    //---------------------------------------------
+    /**
+    @brief O'Neill's PCG64 of a 128 bit LCG of the cheap multiplier and the DXSM output, of numpy
+    */
+    class PCG64DXSM
+    {
+    public:
+        PCG64DXSM();
+        explicit PCG64DXSM(u64 seed);
+        ~PCG64DXSM();
+
+        /**
+        @brief Initialize the state and the increment by SplitMix64 of a seed.
+        @param seed
+        */
+        void srand(u64 seed);
+
+        /**
+        @brief Set the state {low, high} and the increment {low, high}, the increment is made odd
+        */
+        void setState(const u64* state);
+
+        /**
+        @brief Generate a unsigned number in [0 0xFFFF FFFF FFFF FFFFU]
+        */
+        u64 rand();
+
+        /**
+        @brief Generate a double in [0, 1)
+        */
+        f64 drand2();
+
+        /**
+        @brief Advance delta steps in O(log delta)
+        */
+        void discard(u64 delta);
+
+        /**
+        @brief Advance 2^64 steps, same as 2^64 calls of rand()
+        */
+        void jump();
+
+        /**
+        @brief Advance 2^96 steps, same as 2^96 calls of rand()
+        */
+        void longJump();
+
+        static const u32 StateSize = 4; //!< Words of setState
+    private:
+        void step();
+        void advance(u64 deltaLow, u64 deltaHigh);
+
+        u64 low_;
+        u64 high_;
+        u64 incLow_; //!< Odd
+        u64 incHigh_;
+    };
+
+    //---------------------------------------------
+    //---
+    //--- SFC64
+    //---
+    //---------------------------------------------
+    /**
+    @brief Doty-Humphrey's Small Fast Counting generator, a chaotic generator with a counter, which guarantees cycles of at least 2^64
+    */
+    class SFC64
+    {
+    public:
+        SFC64();
+        explicit SFC64(u64 seed);
+        ~SFC64();
+
+        /**
+        @brief Initialize as the reference, three words of the seed and 12 discarded outputs.
+        @param seed
+        */
+        void srand(u64 seed);
+
+        /**
+        @brief Set the state {a, b, c, counter}
+        */
+        void setState(const u64* state);
+
+        /**
+        @brief Generate a unsigned number in [0 0xFFFF FFFF FFFF FFFFU]
+        */
+        u64 rand();
+
+        /**
+        @brief Generate a double in [0, 1)
+        */
+        f64 drand2();
+
+        static const u32 StateSize = 4; //!< Words of setState
+    private:
+        u64 a_;
+        u64 b_;
+        u64 c_;
+        u64 counter_;
+    };
+
+    //---------------------------------------------
+    //---
+    //--- RomuTrio
+    //---
+    //---------------------------------------------
+    /**
+    @brief Overton's RomuTrio, a nonlinear generator of one multiply and two rotations, whose cycles are long with high probability
+    */
+    class RomuTrio
+    {
+    public:
+        RomuTrio();
+        explicit RomuTrio(u64 seed);
+        ~RomuTrio();
+
+        /**
+        @brief Initialize the state by SplitMix64 of a seed.
+        @param seed
+        */
+        void srand(u64 seed);
+
+        /**
+        @brief Set the state words, which should not be all zero
+        */
+        void setState(const u64* state);
+
+        /**
+        @brief Generate a unsigned number in [0 0xFFFF FFFF FFFF FFFFU]
+        */
+        u64 rand();
+
+        /**
+        @brief Generate a double in [0, 1)
+        */
+        f64 drand2();
+
+        static const u32 StateSize = 3; //!< Words of setState
+    private:
+        u64 x_;
+        u64 y_;
+        u64 z_;
+    };
+
     //---------------------------------------------
     //---
     //--- RandWELL
@@ -254,6 +709,11 @@ namespace lcore
         */
         void srand(u32 seed);
 
+        /**
+        @brief Set the state words, which should not be all zero
+        */
+        void setState(const u32* state);
+
         /**
         @brief Generate a unsigned number in [0 0xFFFFFFFFU]
         */
@@ -269,13 +729,516 @@ namespace lcore
         */
         f32 frand2();
 
+        /**
+        @brief Generate a double in [0, 1) of 53 bits from two outputs
+        */
+        f64 drand2();
+
+        /**
+        @brief Fill a buffer with unsigned numbers in [0 0xFFFFFFFFU]
+
+        Same sequence as calling rand() n times.
+        */
+        void fill(u32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with floats in (0, 1]
+        */
+        void ffill(f32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with floats in [0, 1)
+        */
+        void ffill2(f32* out, size_t n);
+
+        /**
+        @brief Fill a buffer with doubles in [0, 1) of 53 bits, from 2n outputs, the first of a pair is the upper half
+        */
+        void dfill2(f64* out, size_t n);
+
+        /**
+        @brief Skip n outputs, same as n calls of rand() in O(log n)
+
+        Jumps by the characteristic polynomial of the state transition over GF(2).
+        */
+        void discard(u64 n);
+
+        static const u32 StateSize = 16; //!< Words of setState
     private:
-        static const u32 N = 16;
+        static const u32 N = StateSize;
+
+        /**
+        @brief Regenerate whole state, and write N outputs
+        */
+        void generate(u32* out);
 
         u32 state_[N];
-        u32 index_;
+        u32 buffer_[N];
+        u32 index_; //!< Next position in buffer_, N when empty
+    };
+
+    //---------------------------------------------
+    //---
+    //--- Conversions
+    //---
+    //---------------------------------------------
+    /**
+    @brief Convert raw outputs to floats in bulk, with the SIMD kernels of RandomKernel.h
+    */
+    void convertF32(f32* out, const u32* in, size_t n, RandomInterval interval, RandomPrecision precision);
+
+    void convertF64(f64* out, const u64* in, size_t n, RandomInterval interval, RandomPrecision precision);
+
+    /**
+    @brief n doubles from 2n outputs of a 32 bit generator, in[2i] is the upper half of the i-th
+    */
+    void convertF64(f64* out, const u32* in, size_t n, RandomInterval interval, RandomPrecision precision);
+
+    /**
+    @brief Convert raw outputs to floats in [vmin, vmax) at full precision
+    */
+    void convertF32(f32* out, const u32* in, size_t n, f32 vmin, f32 vmax);
+
+    void convertF64(f64* out, const u64* in, size_t n, f64 vmin, f64 vmax);
+
+    //---------------------------------------------
+    //---
+    //--- Seeding
+    //---
+    //---------------------------------------------
+    /**
+    @brief SplitMix64 of Steele, Lea and Flood, which expands a 64 bit seed into uncorrelated state words
+    */
+    class SplitMix64
+    {
+    public:
+        static const u64 Gamma = 0x9E3779B97F4A7C15ULL;
+
+        explicit SplitMix64(u64 seed)
+            :state_(seed)
+        {}
+
+        static inline u64 mix(u64 z)
+        {
+            z = (z ^ (z>>30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z>>27)) * 0x94D049BB133111EBULL;
+            return z ^ (z>>31);
+        }
+
+        inline u64 rand()
+        {
+            state_ += Gamma;
+            return mix(state_);
+        }
+
+        /**
+        @brief Same as n calls of rand(), by the SIMD kernels
+        */
+        void fill(u64* out, size_t n);
+
+    private:
+        u64 state_;
+    };
+
+    /**
+    @brief Seed n generators in one pass, the i-th takes the SplitMix64 outputs from i*T::StateSize of seed
+
+    T has StateSize and setState of the word type of rand(), as the generators of Random.h and RandomEngine.h.
+    Words are u64 outputs of SplitMix64, or their lower and upper halves for 32 bit words.
+    */
+    template<class T>
+    void seedMany(T* randoms, size_t n, u64 seed)
+    {
+        typedef decltype(std::declval<T&>().rand()) word_type;
+        static const u32 BlockSize = 1024;
+        static const u32 Words = (T::StateSize*sizeof(word_type) + sizeof(u64) - 1)/sizeof(u64);
+        static const u32 Count = (BlockSize<Words)? 1 : BlockSize/Words;
+        LASSERT(NULL != randoms || 0 == n);
+
+        SplitMix64 splitMix(seed);
+        u64 block[(BlockSize<Words)? Words : BlockSize];
+        while(0<n){
+            const u32 count = (Count<n)? Count : static_cast<u32>(n);
+            splitMix.fill(block, count*Words);
+            for(u32 i=0; i<count; ++i){
+                word_type state[T::StateSize];
+                memcpy(state, block + i*Words, sizeof(state));
+                randoms[i].setState(state);
+            }
+            randoms += count;
+            n -= count;
+        }
+    }
+
+    /**
+    @brief Seed by SplitMix64 expansion of a 64 bit seed, same as seedMany of one generator
+    */
+    template<class T>
+    void seedSplitMix64(T& random, u64 seed)
+    {
+        seedMany(&random, 1, seed);
+    }
+
+    //---------------------------------------------
+    //---
+    //--- StreamFactory
+    //---
+    //---------------------------------------------
+    /**
+    @brief Hand out non-overlapping generators for the jump capable generators
+
+    The i-th created generator is the base advanced by i*W jump() calls (or i longJump() calls),
+    where W is FillLanes for the generators whose fill() runs lanes one jump() apart, and 1 for the others.
+    So each one owns W whole jump distances, e.g. 16*2^64 values of Xoshiro128Plus with all lanes of fill(), before it reaches the next one.
+    The lanes of fill() are 15 jump() at most, which stay in one longJump() distance.
+    The same base always gives the same sequence of generators.
+    For two levels, e.g. processes and threads, split processes with longJump and threads with jump.
+    */
+    template<class T>
+    class StreamFactory
+    {
+    public:
+        /**
+        @param base ... the first stream
+        @param longJump ... use longJump() instead of jump() between streams
+        */
+        explicit StreamFactory(const T& base, bool longJump=false)
+            :next_(base)
+            ,longJump_(longJump)
+        {}
+
+        /**
+        @brief Create the next stream
+        */
+        T create()
+        {
+            T random(next_);
+            if(longJump_){
+                next_.longJump();
+            }else{
+                for(u32 i=0; i<JumpsPerStream; ++i){
+                    next_.jump();
+                }
+            }
+            return random;
+        }
+
+        /**
+        @brief Create the next num streams
+        */
+        void create(T* randoms, u32 num)
+        {
+            LASSERT(NULL != randoms || 0 == num);
+            for(u32 i=0; i<num; ++i){
+                randoms[i] = create();
+            }
+        }
+
+    private:
+        template<class U>
+        static auto getFillLanes(int) -> std::integral_constant<u32, U::FillLanes>;
+
+        template<class U>
+        static auto getFillLanes(long) -> std::integral_constant<u32, 1>;
+
+    public:
+        static const u32 JumpsPerStream = decltype(getFillLanes<T>(0))::value; //!< jump() between streams
+
+    private:
+        T next_;
+        bool longJump_;
     };
 
+    //----------------------------------------------------
+    //---
+    //--- Bounded integers
+    //---
+    //----------------------------------------------------
+    /**
+    @brief Upper 64 bits of x*y, and the lower 64 bits to low
+    */
+    inline u64 mul64(u64 x, u64 y, u64& low)
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 m = static_cast<unsigned __int128>(x)*y;
+        low = static_cast<u64>(m);
+        return static_cast<u64>(m>>64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        u64 high;
+        low = _umul128(x, y, &high);
+        return high;
+#else
+        u64 x0 = x&0xFFFFFFFFULL, x1 = x>>32;
+        u64 y0 = y&0xFFFFFFFFULL, y1 = y>>32;
+        u64 p00 = x0*y0;
+        u64 p01 = x0*y1;
+        u64 p10 = x1*y0;
+        u64 middle = (p00>>32) + (p01&0xFFFFFFFFULL) + (p10&0xFFFFFFFFULL);
+        low = (middle<<32) | (p00&0xFFFFFFFFULL);
+        return x1*y1 + (p01>>32) + (p10>>32) + (middle>>32);
+#endif
+    }
+
+    /**
+    @brief 32 or 64 random bits from a generator of either width of rand()
+
+    64 bit generators give their upper bits as 32 bits, and 32 bit generators combine two outputs as 64 bits.
+    */
+    template<class T>
+    struct RandomBits
+    {
+        typedef decltype(std::declval<T&>().rand()) result_type;
+        static const bool Is64 = (8 == sizeof(result_type));
+
+        /**
+        @brief Batches shorter than this are filled by rand(), so that fill() setup costs nothing to small batches
+        */
+        static const size_t FillThreshold = 256;
+
+        static u32 rand32(T& random)
+        {
+            return rand32(random, std::integral_constant<bool, Is64>());
+        }
+
+        static u64 rand64(T& random)
+        {
+            return rand64(random, std::integral_constant<bool, Is64>());
+        }
+
+        /**
+        @brief Same as size calls of rand32, or fill() of the generator if it has
+        */
+        static void fill32(T& random, u32* values, size_t size)
+        {
+            if(size<FillThreshold){
+                for(size_t i=0; i<size; ++i){
+                    values[i] = rand32(random);
+                }
+            }else{
+                fill32(random, values, size, 0);
+            }
+        }
+
+        /**
+        @brief Same as size calls of rand64, 32 bit generators fill through fill32
+        */
+        static void fill64(T& random, u64* values, size_t size)
+        {
+            fill64(random, values, size, std::integral_constant<bool, Is64>());
+        }
+
+    private:
+        static u32 rand32(T& random, std::false_type)
+        {
+            return static_cast<u32>(random.rand());
+        }
+
+        static u32 rand32(T& random, std::true_type)
+        {
+            return static_cast<u32>(random.rand()>>32);
+        }
+
+        static u64 rand64(T& random, std::false_type)
+        {
+            u64 high = static_cast<u32>(random.rand());
+            return (high<<32) | static_cast<u32>(random.rand());
+        }
+
+        static u64 rand64(T& random, std::true_type)
+        {
+            return random.rand();
+        }
+
+        static void fill64(T& random, u64* values, size_t size, std::false_type)
+        {
+            static const size_t BlockSize = 512;
+            u32 block[2*BlockSize];
+            while(0<size){
+                const size_t n = (BlockSize<size)? BlockSize : size;
+                fill32(random, block, 2*n);
+                for(size_t i=0; i<n; ++i){
+                    values[i] = (static_cast<u64>(block[2*i])<<32) | block[2*i+1];
+                }
+                values += n;
+                size -= n;
+            }
+        }
+
+        static void fill64(T& random, u64* values, size_t size, std::true_type)
+        {
+            for(size_t i=0; i<size; ++i){
+                values[i] = random.rand();
+            }
+        }
+
+        template<class R>
+        static auto fill32(R& random, u32* values, size_t size, int) -> decltype(random.fill(values, size), void())
+        {
+            random.fill(values, size);
+        }
+
+        template<class R>
+        static void fill32(R& random, u32* values, size_t size, long)
+        {
+            for(size_t i=0; i<size; ++i){
+                values[i] = rand32(random);
+            }
+        }
+    };
+
+    /**
+    @brief [0, range) by Lemire's nearly divisionless multiply and shift, 0 if range is 0
+
+    A division happens only when the low half of the product falls below range, with probability range/2^32.
+    */
+    template<class T>
+    u32 boundedRandom32(T& random, u32 range)
+    {
+        u64 m = static_cast<u64>(RandomBits<T>::rand32(random)) * range;
+        u32 low = static_cast<u32>(m);
+        if(low<range){
+            //Reject the low halves which would map more values to some results than others
+            const u32 threshold = (0U-range) % range;
+            while(low<threshold){
+                m = static_cast<u64>(RandomBits<T>::rand32(random)) * range;
+                low = static_cast<u32>(m);
+            }
+        }
+        return static_cast<u32>(m>>32);
+    }
+
+    /**
+    @brief [0, range) by Lemire's nearly divisionless multiply and shift, 0 if range is 0
+    */
+    template<class T>
+    u64 boundedRandom64(T& random, u64 range)
+    {
+        u64 low;
+        u64 high = mul64(RandomBits<T>::rand64(random), range, low);
+        if(low<range){
+            const u64 threshold = (0ULL-range) % range;
+            while(low<threshold){
+                high = mul64(RandomBits<T>::rand64(random), range, low);
+            }
+        }
+        return high;
+    }
+
+    /**
+    @brief values[i] = (bits[i]*range)>>32, by the SIMD kernels
+    @return true if the lower half of any product is less than threshold, which rejects its value
+    */
+    bool mulHighU32(u32* values, const u32* bits, size_t n, u32 range, u32 threshold);
+
+    /**
+    @brief Fill values with [0, range), 0 if range is 0
+
+    The rejection threshold, a division, is computed once for all values,
+    and the multiplies of a block run in the SIMD kernels with a mask of the rejected lanes.
+    Rejected values are drawn again after their block, so the sequence differs from size calls of boundedRandom32.
+    */
+    template<class T>
+    void boundedRandom32(T& random, u32* values, size_t size, u32 range)
+    {
+        static const size_t BlockSize = 1024;
+        LASSERT(NULL != values || 0 == size);
+        if(0 == range){
+            for(size_t i=0; i<size; ++i){
+                values[i] = 0;
+            }
+            return;
+        }
+        const u32 threshold = (0U-range) % range;
+        u32 bits[BlockSize];
+        while(0<size){
+            const size_t n = (BlockSize<size)? BlockSize : size;
+            RandomBits<T>::fill32(random, bits, n);
+            if(mulHighU32(values, bits, n, range, threshold)){
+                for(size_t i=0; i<n; ++i){
+                    u64 m = static_cast<u64>(bits[i]) * range;
+                    while(static_cast<u32>(m)<threshold){
+                        m = static_cast<u64>(RandomBits<T>::rand32(random)) * range;
+                    }
+                    values[i] = static_cast<u32>(m>>32);
+                }
+            }
+            values += n;
+            size -= n;
+        }
+    }
+
+    /**
+    @brief Fill values with [0, range), 0 if range is 0
+    */
+    template<class T>
+    void boundedRandom64(T& random, u64* values, size_t size, u64 range)
+    {
+        LASSERT(NULL != values || 0 == size);
+        if(range<=0xFFFFFFFFULL){
+            static const size_t BlockSize = 256;
+            u32 block[BlockSize];
+            for(size_t i=0; i<size; i+=BlockSize){
+                const size_t n = (BlockSize<(size-i))? BlockSize : size-i;
+                boundedRandom32(random, block, n, static_cast<u32>(range));
+                for(size_t j=0; j<n; ++j){
+                    values[i+j] = block[j];
+                }
+            }
+            return;
+        }
+        const u64 threshold = (0ULL-range) % range;
+        for(size_t i=0; i<size; ++i){
+            u64 low;
+            u64 high = mul64(RandomBits<T>::rand64(random), range, low);
+            while(low<threshold){
+                high = mul64(RandomBits<T>::rand64(random), range, low);
+            }
+            values[i] = high;
+        }
+    }
+
+    /**
+    @brief [0, range) of unsigned U, 0 if range is 0
+    */
+    template<class T, class U>
+    U boundedRandom(T& random, U range)
+    {
+        static_assert(std::is_unsigned<U>::value, "U should be unsigned");
+        if(sizeof(U)<=sizeof(u32) || range<=static_cast<U>(0xFFFFFFFFU)){
+            return static_cast<U>(boundedRandom32(random, static_cast<u32>(range)));
+        }
+        return static_cast<U>(boundedRandom64(random, static_cast<u64>(range)));
+    }
+
+    /**
+    @brief Fill values with vmin + [0, range), in blocks of 32 or 64 bit bounded values
+    */
+    template<class T, class U, class V>
+    void fillBounded(T& random, U* values, size_t size, V vmin, V range)
+    {
+        static const size_t BlockSize = 1024;
+        LASSERT(NULL != values || 0 == size);
+        if(sizeof(V)<=sizeof(u32) || range<=static_cast<V>(0xFFFFFFFFU)){
+            u32 block[BlockSize];
+            for(size_t i=0; i<size; i+=BlockSize){
+                const size_t n = (BlockSize<(size-i))? BlockSize : size-i;
+                boundedRandom32(random, block, n, static_cast<u32>(range));
+                for(size_t j=0; j<n; ++j){
+                    values[i+j] = static_cast<U>(vmin + static_cast<V>(block[j]));
+                }
+            }
+        }else{
+            u64 block[BlockSize];
+            for(size_t i=0; i<size; i+=BlockSize){
+                const size_t n = (BlockSize<(size-i))? BlockSize : size-i;
+                boundedRandom64(random, block, n, static_cast<u64>(range));
+                for(size_t j=0; j<n; ++j){
+                    values[i+j] = static_cast<U>(vmin + static_cast<V>(block[j]));
+                }
+            }
+        }
+    }
+
     //----------------------------------------------------
     /**
     @brief [vmin, vmax)
@@ -284,7 +1247,9 @@ namespace lcore
     U range_ropen(T& random, U vmin, U vmax)
     {
         LASSERT(vmin<=vmax);
-        return static_cast<U>(random.rand() % (vmax-vmin)) + vmin;
+        typedef typename std::make_unsigned<U>::type unsigned_type;
+        unsigned_type range = static_cast<unsigned_type>(static_cast<unsigned_type>(vmax) - static_cast<unsigned_type>(vmin));
+        return static_cast<U>(static_cast<unsigned_type>(vmin) + boundedRandom(random, range));
     }
 
     /**
@@ -304,7 +1269,13 @@ namespace lcore
     U range_rclose(T& random, U vmin, U vmax)
     {
         LASSERT(vmin<=vmax);
-        return static_cast<U>(random.rand() % (vmax-vmin+1)) + vmin;
+        typedef typename std::make_unsigned<U>::type unsigned_type;
+        unsigned_type range = static_cast<unsigned_type>(static_cast<unsigned_type>(vmax) - static_cast<unsigned_type>(vmin) + 1U);
+        if(0 == range){
+            //The full range of U
+            return static_cast<U>(RandomBits<T>::rand64(random));
+        }
+        return static_cast<U>(static_cast<unsigned_type>(vmin) + boundedRandom(random, range));
     }
 
     /**
@@ -325,7 +1296,38 @@ namespace lcore
     U range_ropen(T& random, U v)
     {
         LASSERT(0<=v);
-        return static_cast<U>(random.rand() % v);
+        typedef typename std::make_unsigned<U>::type unsigned_type;
+        return static_cast<U>(boundedRandom(random, static_cast<unsigned_type>(v)));
+    }
+
+    /**
+    @brief Fill values with [vmin, vmax)
+    */
+    template<class T, class U>
+    void range_ropen(T& random, U* values, size_t size, U vmin, U vmax)
+    {
+        LASSERT(vmin<=vmax);
+        typedef typename std::make_unsigned<U>::type unsigned_type;
+        unsigned_type range = static_cast<unsigned_type>(static_cast<unsigned_type>(vmax) - static_cast<unsigned_type>(vmin));
+        fillBounded(random, values, size, static_cast<unsigned_type>(vmin), range);
+    }
+
+    /**
+    @brief Fill values with [vmin, vmax]
+    */
+    template<class T, class U>
+    void range_rclose(T& random, U* values, size_t size, U vmin, U vmax)
+    {
+        LASSERT(vmin<=vmax);
+        typedef typename std::make_unsigned<U>::type unsigned_type;
+        unsigned_type range = static_cast<unsigned_type>(static_cast<unsigned_type>(vmax) - static_cast<unsigned_type>(vmin) + 1U);
+        if(0 == range){
+            for(size_t i=0; i<size; ++i){
+                values[i] = static_cast<U>(RandomBits<T>::rand64(random));
+            }
+            return;
+        }
+        fillBounded(random, values, size, static_cast<unsigned_type>(vmin), range);
     }
 
     template<class T, class U>
@@ -348,7 +1350,11 @@ namespace lcore
         }
 	}
 
-    void cryptRandom(u32 size, void* buffer);
+    /**
+    @brief Fill a buffer with cryptographically secure random bytes, from a CryptRandom of the calling thread
+    @return false and zeros if the system gave no entropy
+    */
+    bool cryptRandom(u32 size, void* buffer);
 }
 
 #endif //INC_RANDOM_H_
@@ -0,0 +1,22 @@
+/**
+@file RandomCounter.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "RandomCounter.h"
+#include "RandomKernel.h"
+
+namespace lcore
+{
+    void Philox4x32::generate(u32* out, const Key& key, u64 counter, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        getRandomKernels().philox4x32_(out, key.key_, key.stream_, counter, n);
+    }
+
+    void Squares32::generate(u32* out, const Key& key, u64 counter, size_t n)
+    {
+        LASSERT(NULL != out || 0 == n);
+        getRandomKernels().squares32_(out, key.key_, counter, n);
+    }
+}
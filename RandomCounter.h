@@ -0,0 +1,310 @@
+#ifndef INC_RANDOMCOUNTER_H_
+#define INC_RANDOMCOUNTER_H_
+/**
+@file RandomCounter.h
+@author t-sakai
+@date 2026/10/17 create
+
+Counter-based generators, whose value at any position is a function of (key, stream, counter) without a state to advance.
+
+Philox4x32 is Philox4x32-10 of Salmon et al., four values for each 128 bit counter of (counter, stream) under a 64 bit key.
+Squares32 is Widynski's Squares, one value for each 64 bit counter, with the key made from (key, stream).
+The batch versions run the kernels of RandomKernel.h, so a value for entity i at step t is just
+
+    Philox4x32::generate(out, Philox4x32::makeKey(seed, i), t);
+
+CounterRandom adapts them to rand/frand/frand2 and fill of the other generators.
+*/
+#include "Random.h"
+
+namespace lcore
+{
+    //---------------------------------------------
+    //---
+    //--- Philox4x32
+    //---
+    //---------------------------------------------
+    struct Philox4x32
+    {
+        static const u32 Width = 4; //!< Values of a counter
+        static const u32 Rounds = 10;
+        static const u32 M0 = 0xD2511F53U;
+        static const u32 M1 = 0xCD9E8D57U;
+        static const u32 W0 = 0x9E3779B9U; //!< Key increments
+        static const u32 W1 = 0xBB67AE85U;
+
+        /**
+        @brief One block of the counter words and the key words
+        */
+        static inline void block(u32 out[4], const u32 counter[4], const u32 key[2])
+        {
+            u32 c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+            u32 k0 = key[0], k1 = key[1];
+            for(u32 i=0; i<Rounds; ++i){
+                const u64 p0 = static_cast<u64>(M0)*c0;
+                const u64 p1 = static_cast<u64>(M1)*c2;
+                c0 = static_cast<u32>(p1>>32) ^ c1 ^ k0;
+                c1 = static_cast<u32>(p1);
+                c2 = static_cast<u32>(p0>>32) ^ c3 ^ k1;
+                c3 = static_cast<u32>(p0);
+                k0 += W0;
+                k1 += W1;
+            }
+            out[0] = c0;
+            out[1] = c1;
+            out[2] = c2;
+            out[3] = c3;
+        }
+
+        struct Key
+        {
+            u64 key_;
+            u64 stream_;
+        };
+
+        static inline Key makeKey(u64 key, u64 stream)
+        {
+            Key k = {key, stream};
+            return k;
+        }
+
+        /**
+        @brief Four values of the counter (counter, stream)
+        */
+        static inline void generate(u32 out[4], const Key& key, u64 counter)
+        {
+            const u32 c[4] = {static_cast<u32>(counter), static_cast<u32>(counter>>32), static_cast<u32>(key.stream_), static_cast<u32>(key.stream_>>32)};
+            const u32 k[2] = {static_cast<u32>(key.key_), static_cast<u32>(key.key_>>32)};
+            block(out, c, k);
+        }
+
+        /**
+        @brief 4n values of the counters counter to counter+n-1, out[4i+j] is the j-th of counter+i
+        */
+        static void generate(u32* out, const Key& key, u64 counter, size_t n);
+    };
+
+    //---------------------------------------------
+    //---
+    //--- Squares32
+    //---
+    //---------------------------------------------
+    struct Squares32
+    {
+        static const u32 Width = 1; //!< Values of a counter
+
+        struct Key
+        {
+            u64 key_;
+        };
+
+        /**
+        @brief Key of Squares from a key and a stream
+
+        Squares needs keys of irregular bits, so the key is a SplitMix64 output forced odd, instead of a user value.
+        */
+        static inline Key makeKey(u64 key, u64 stream)
+        {
+            Key k = {SplitMix64::mix(key + (stream+1)*SplitMix64::Gamma) | 1ULL};
+            return k;
+        }
+
+        /**
+        @brief Four rounds of squaring
+        */
+        static inline u32 squares(u64 counter, u64 key)
+        {
+            u64 x = counter*key;
+            const u64 y = x;
+            const u64 z = y + key;
+            x = x*x + y; x = (x>>32) | (x<<32);
+            x = x*x + z; x = (x>>32) | (x<<32);
+            x = x*x + y; x = (x>>32) | (x<<32);
+            return static_cast<u32>((x*x + z)>>32);
+        }
+
+        static inline void generate(u32 out[1], const Key& key, u64 counter)
+        {
+            out[0] = squares(counter, key.key_);
+        }
+
+        /**
+        @brief n values of the counters counter to counter+n-1
+        */
+        static void generate(u32* out, const Key& key, u64 counter, size_t n);
+    };
+
+    //---------------------------------------------
+    //---
+    //--- CounterRandom
+    //---
+    //---------------------------------------------
+    /**
+    @brief The interface of the other generators over the values of one stream of a counter-based generator
+
+    The position is the index of the next value of the stream, which seek sets in O(1).
+    */
+    template<class T>
+    class CounterRandom
+    {
+    public:
+        static const u32 Width = T::Width;
+
+        explicit CounterRandom(u64 key, u64 stream=0)
+            :key_(T::makeKey(key, stream))
+            ,counter_(0)
+            ,index_(Width)
+        {}
+
+        u64 position() const
+        {
+            return counter_*Width - (Width-index_);
+        }
+
+        void seek(u64 position)
+        {
+            counter_ = position/Width;
+            index_ = Width;
+            const u32 skip = static_cast<u32>(position%Width);
+            if(0<skip){
+                T::generate(buffer_, key_, counter_);
+                ++counter_;
+                index_ = skip;
+            }
+        }
+
+        /**
+        @brief The value at position, without changing the position
+        */
+        u32 at(u64 position) const
+        {
+            u32 values[Width];
+            T::generate(values, key_, position/Width);
+            return values[position%Width];
+        }
+
+        u32 rand()
+        {
+            if(Width<=index_){
+                T::generate(buffer_, key_, counter_);
+                ++counter_;
+                index_ = 0;
+            }
+            return buffer_[index_++];
+        }
+
+        /**
+        @brief Generate a float in (0, 1]
+        */
+        f32 frand()
+        {
+            return toF32(rand()) - 0.999999881f;
+        }
+
+        /**
+        @brief Generate a float in [0, 1)
+        */
+        f32 frand2()
+        {
+            return toF32(rand()) - 1.0f;
+        }
+
+        /**
+        @brief Generate a double in [0, 1) of 53 bits from two outputs
+        */
+        f64 drand2()
+        {
+            const u64 high = rand();
+            return static_cast<f64>(((high<<32) | rand())>>11) * (1.0/9007199254740992.0);
+        }
+
+        /**
+        @brief Same as n calls of rand(), whole counters by the batch kernels
+        */
+        void fill(u32* out, size_t n)
+        {
+            LASSERT(NULL != out || 0 == n);
+            for(; index_<Width && 0<n; --n){
+                *out = buffer_[index_++];
+                ++out;
+            }
+            const size_t blocks = n/Width;
+            T::generate(out, key_, counter_, blocks);
+            counter_ += blocks;
+            out += blocks*Width;
+            n -= blocks*Width;
+            for(; 0<n; --n){
+                *out = rand();
+                ++out;
+            }
+        }
+
+        /**
+        @brief Fill a buffer with floats in (0, 1]
+        */
+        void ffill(f32* out, size_t n)
+        {
+            ffill(out, n, RandomInterval_OpenClosed);
+        }
+
+        /**
+        @brief Fill a buffer with floats in [0, 1)
+        */
+        void ffill2(f32* out, size_t n)
+        {
+            ffill(out, n, RandomInterval_ClosedOpen);
+        }
+
+        /**
+        @brief Fill a buffer with doubles in [0, 1) of 53 bits, from 2n values of fill, the first of a pair is the upper half
+        */
+        void dfill2(f64* out, size_t n)
+        {
+            LASSERT(NULL != out || 0 == n);
+            static const u32 BlockSize = 512;
+            u32 block[2*BlockSize];
+            while(0<n){
+                u32 count = (BlockSize<n)? BlockSize : static_cast<u32>(n);
+                fill(block, 2*count);
+                lcore::convertF64(out, block, count, RandomInterval_ClosedOpen, RandomPrecision_Full);
+                out += count;
+                n -= count;
+            }
+        }
+
+    private:
+        /**
+        @brief [1, 2) of 23 bits
+        */
+        static inline f32 toF32(u32 x)
+        {
+            x = 0x3F800000U | (x&0x007FFFFFU);
+            f32 f;
+            memcpy(&f, &x, sizeof(f32));
+            return f;
+        }
+
+        void ffill(f32* out, size_t n, RandomInterval interval)
+        {
+            LASSERT(NULL != out || 0 == n);
+            static const u32 BlockSize = 1024;
+            u32 block[BlockSize];
+            while(0<n){
+                u32 count = (BlockSize<n)? BlockSize : static_cast<u32>(n);
+                fill(block, count);
+                lcore::convertF32(out, block, count, interval, RandomPrecision_Fast);
+                out += count;
+                n -= count;
+            }
+        }
+
+        typename T::Key key_;
+        u64 counter_; //!< Next counter to generate
+        u32 index_; //!< Next value of buffer_, Width when empty
+        u32 buffer_[Width];
+    };
+
+    typedef CounterRandom<Philox4x32> PhiloxRandom;
+    typedef CounterRandom<Squares32> SquaresRandom;
+}
+#endif //INC_RANDOMCOUNTER_H_
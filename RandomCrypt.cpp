@@ -0,0 +1,295 @@
+/**
+@file RandomCrypt.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "RandomCrypt.h"
+#include "RandomKernel.h"
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#ifdef _WIN32
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif //WIN32_LEAN_AND_MEAN
+
+#include <windows.h>
+
+#else //_WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif //_WIN32
+
+namespace lcore
+{
+    namespace
+    {
+        std::atomic<u32> forkCount(0);
+
+#ifndef _WIN32
+        void onForkChild()
+        {
+            forkCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        bool readDevice(u8* buffer, size_t size)
+        {
+            s32 fd;
+            do{
+                fd = open("/dev/urandom", O_RDONLY);
+            }while(fd<0 && EINTR == errno);
+            if(fd<0){
+                return false;
+            }
+            while(0<size){
+                ssize_t result = read(fd, buffer, size);
+                if(result<0){
+                    if(EINTR == errno){
+                        continue;
+                    }
+                    break;
+                }
+                if(0 == result){
+                    break;
+                }
+                buffer += result;
+                size -= static_cast<size_t>(result);
+            }
+            close(fd);
+            return 0 == size;
+        }
+#endif
+
+        /**
+        @brief Count forks from the first generator on
+        */
+        void registerFork()
+        {
+#ifndef _WIN32
+            static std::once_flag flag;
+            std::call_once(flag, [](){
+                pthread_atfork(NULL, NULL, onForkChild);
+            });
+#endif
+        }
+
+        /**
+        @brief memset which the compiler does not remove as a dead store
+        */
+        void wipe(void* buffer, size_t size)
+        {
+#if defined(__GNUC__)
+            memset(buffer, 0, size);
+            __asm__ __volatile__("" : : "r"(buffer) : "memory");
+#else
+            volatile u8* p = static_cast<volatile u8*>(buffer);
+            for(size_t i=0; i<size; ++i){
+                p[i] = 0;
+            }
+#endif
+        }
+    }
+
+    bool getSystemEntropy(void* buffer, size_t size)
+    {
+        LASSERT(NULL != buffer || 0 == size);
+#ifdef _WIN32
+        bool result = false;
+        HMODULE handle = LoadLibrary("Advapi32.dll");
+        if(NULL != handle){
+            FARPROC procAddress = GetProcAddress(handle, "SystemFunction036");
+            if(NULL != procAddress){
+                result = 0 != (*(BOOLEAN (*)(PVOID, ULONG))procAddress)(buffer, static_cast<ULONG>(size));
+            }
+            FreeLibrary(handle);
+        }
+        return result;
+#else
+        u8* p = static_cast<u8*>(buffer);
+#if defined(__linux__) && defined(SYS_getrandom)
+        //Blocks only until the pool is initialized, and may return short for large sizes
+        while(0<size){
+            long result = syscall(SYS_getrandom, p, size, 0);
+            if(result<0){
+                if(EINTR == errno){
+                    continue;
+                }
+                return readDevice(p, size);
+            }
+            p += result;
+            size -= static_cast<size_t>(result);
+        }
+        return true;
+#else
+        return readDevice(p, size);
+#endif
+#endif
+    }
+
+    //---------------------------------------------
+    //---
+    //--- CryptRandom
+    //---
+    //---------------------------------------------
+    CryptRandom::CryptRandom()
+        :seeded_(false)
+        ,forkGeneration_(0)
+        ,bytes_(0)
+        ,position_(sizeof(buffer_))
+    {
+        registerFork();
+        memset(key_, 0, sizeof(key_));
+        reseed();
+    }
+
+    CryptRandom::~CryptRandom()
+    {
+        wipe(key_, sizeof(key_));
+        wipe(buffer_, sizeof(buffer_));
+    }
+
+    bool CryptRandom::reseed()
+    {
+        u32 entropy[KeySize];
+        seeded_ = getSystemEntropy(entropy, sizeof(entropy));
+        if(seeded_){
+            for(u32 i=0; i<KeySize; ++i){
+                key_[i] ^= entropy[i];
+            }
+        }
+        wipe(entropy, sizeof(entropy));
+        //The buffer is from the old key
+        wipe(buffer_, sizeof(buffer_));
+        position_ = sizeof(buffer_);
+        forkGeneration_ = forkCount.load(std::memory_order_relaxed);
+        bytes_ = 0;
+        return seeded_;
+    }
+
+    u32 CryptRandom::rand()
+    {
+        u32 x;
+        fill(&x, sizeof(x));
+        return x;
+    }
+
+    u64 CryptRandom::rand64()
+    {
+        u64 x;
+        fill(&x, sizeof(x));
+        return x;
+    }
+
+    bool CryptRandom::fill(void* buffer, size_t size)
+    {
+        LASSERT(NULL != buffer || 0 == size);
+        check();
+        if(!seeded_){
+            memset(buffer, 0, size);
+            return false;
+        }
+        bytes_ += size;
+
+        u8* out = static_cast<u8*>(buffer);
+        for(;;){
+            size_t count = sizeof(buffer_) - position_;
+            count = (size<count)? size : count;
+            memcpy(out, buffer_+position_, count);
+            wipe(buffer_+position_, count);
+            position_ += static_cast<u32>(count);
+            out += count;
+            size -= count;
+            if(0 == size){
+                break;
+            }
+            //Whole blocks of large requests go to out without the buffer
+            static const size_t MaxBlocks = 1024;
+            size_t blocks = size/BlockSize;
+            while(BufferBlocks<=blocks){
+                size_t n = (MaxBlocks<blocks)? MaxBlocks : blocks;
+                generate(out, n);
+                out += n*BlockSize;
+                size -= n*BlockSize;
+                blocks -= n;
+            }
+            if(0 == size){
+                break;
+            }
+            refill();
+        }
+        return true;
+    }
+
+    void CryptRandom::check()
+    {
+        if(!seeded_
+            || ReseedInterval<=bytes_
+            || forkGeneration_ != forkCount.load(std::memory_order_relaxed))
+        {
+            reseed();
+        }
+    }
+
+    void CryptRandom::initialize(u32 state[16]) const
+    {
+        static const u32 Constants[4] = {0x61707865U, 0x3320646eU, 0x79622d32U, 0x6b206574U};
+        memcpy(state, Constants, sizeof(Constants));
+        memcpy(state+4, key_, sizeof(key_));
+        state[12] = state[13] = state[14] = state[15] = 0;
+    }
+
+    void CryptRandom::generate(u8* out, size_t blocks)
+    {
+        u32 state[16];
+        u32 next[16];
+        initialize(state);
+        state[12] = 1;
+
+        const RandomKernels::ChaCha20Blocks chacha20 = getRandomKernels().chacha20_;
+        if(0 == (reinterpret_cast<uintptr_t>(out) & (sizeof(u32)-1))){
+            chacha20(reinterpret_cast<u32*>(out), state, blocks);
+        }else{
+            u32 block[16*BufferBlocks];
+            for(size_t i=0; i<blocks; i+=BufferBlocks){
+                size_t n = ((blocks-i)<BufferBlocks)? blocks-i : BufferBlocks;
+                chacha20(block, state, n);
+                memcpy(out + i*BlockSize, block, n*BlockSize);
+                state[12] += static_cast<u32>(n);
+            }
+            wipe(block, sizeof(block));
+        }
+
+        //The block of the counter 0 is the next key
+        state[12] = 0;
+        chacha20(next, state, 1);
+        memcpy(key_, next, sizeof(key_));
+        wipe(next, sizeof(next));
+        wipe(state, sizeof(state));
+    }
+
+    void CryptRandom::refill()
+    {
+        //The block of the counter 0 is the next key, in the same call as the served blocks
+        u32 state[16];
+        initialize(state);
+        getRandomKernels().chacha20_(reinterpret_cast<u32*>(buffer_), state, BufferBlocks);
+        memcpy(key_, buffer_, sizeof(key_));
+        wipe(buffer_, BlockSize);
+        wipe(state, sizeof(state));
+        position_ = BlockSize;
+    }
+
+    //---------------------------------------------
+    bool cryptRandom(u32 size, void* buffer)
+    {
+        LASSERT(NULL != buffer || 0 == size);
+        static thread_local CryptRandom random;
+        return random.fill(buffer, size);
+    }
+}
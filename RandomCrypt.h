@@ -0,0 +1,83 @@
+#ifndef INC_RANDOMCRYPT_H_
+#define INC_RANDOMCRYPT_H_
+/**
+@file RandomCrypt.h
+@author t-sakai
+@date 2026/10/17 create
+
+A cryptographically secure generator of ChaCha20 keystream, which cryptRandom keeps for each thread.
+
+Each refill runs ChaCha20 under the current key and replaces the key by one more block, so the served bytes cannot be
+recomputed from a later state (fast key erasure). The served bytes are also erased from the buffer.
+The key is mixed with the system entropy of getSystemEntropy on the creation, every ReseedInterval bytes,
+and in the child of a fork, so that two processes never share a keystream.
+*/
+#include "Random.h"
+
+namespace lcore
+{
+    /**
+    @brief Fill a buffer from the entropy of the system, getrandom or /dev/urandom, or RtlGenRandom
+    @return false if no source gave all bytes
+    */
+    bool getSystemEntropy(void* buffer, size_t size);
+
+    class CryptRandom
+    {
+    public:
+        static const u32 KeySize = 8; //!< 256 bits
+        static const u32 BlockSize = 64; //!< bytes of a ChaCha20 block
+        static const u32 BufferBlocks = 32;
+        static const u64 ReseedInterval = 16ULL*1024*1024; //!< bytes
+
+        /**
+        @brief Seeded from the system, check seeded()
+        */
+        CryptRandom();
+        ~CryptRandom();
+
+        /**
+        @brief Whether the last seeding got system entropy, the output is not secure without
+        */
+        bool seeded() const{ return seeded_;}
+
+        /**
+        @brief Mix new system entropy into the key
+        */
+        bool reseed();
+
+        u32 rand();
+        u64 rand64();
+
+        /**
+        @brief Fill a buffer with keystream
+        @return false and zeros if the generator has no system entropy
+        */
+        bool fill(void* buffer, size_t size);
+
+    private:
+        CryptRandom(const CryptRandom&) = delete;
+        CryptRandom& operator=(const CryptRandom&) = delete;
+
+        /**
+        @brief Reseed when due, or when a fork happened after the last seeding
+        */
+        void check();
+
+        void initialize(u32 state[16]) const;
+
+        /**
+        @brief Blocks of keystream to out, then a new key
+        */
+        void generate(u8* out, size_t blocks);
+        void refill();
+
+        bool seeded_;
+        u32 forkGeneration_;
+        u64 bytes_; //!< since the last seeding
+        u32 key_[KeySize];
+        u32 position_; //!< Next byte of buffer_, sizeof(buffer_) when empty
+        alignas(16) u8 buffer_[BufferBlocks*BlockSize];
+    };
+}
+#endif //INC_RANDOMCRYPT_H_
@@ -0,0 +1,194 @@
+/**
+@file RandomDistribution.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "RandomDistribution.h"
+
+namespace lcore
+{
+    namespace
+    {
+        /**
+        @brief Layers of equal area v, from the tail start r
+        */
+        void initializeZiggurat(ZigguratTable& table, bool symmetric, f64 r, f64 v)
+        {
+            static const u32 Layers = ZigguratTable::Layers;
+            table.symmetric_ = symmetric;
+            table.signMask32_ = (symmetric)? 0x80000000U : 0U;
+            table.signMask64_ = (symmetric)? 0x8000000000000000ULL : 0ULL;
+            table.r_ = r;
+
+            table.x_[0] = v/table.density(r);
+            table.x_[1] = r;
+            for(u32 i=2; i<Layers; ++i){
+                const f64 y = v/table.x_[i-1] + table.density(table.x_[i-1]);
+                table.x_[i] = (symmetric)? std::sqrt(-2.0*std::log(y)) : -std::log(y);
+            }
+            table.x_[Layers] = 0.0;
+
+            for(u32 i=0; i<=Layers; ++i){
+                table.f_[i] = table.density(table.x_[i]);
+            }
+            for(u32 i=0; i<Layers; ++i){
+                table.ratio_[i] = table.x_[i+1]/table.x_[i];
+                table.xf_[i] = static_cast<f32>(table.x_[i]);
+                f32 ratio = static_cast<f32>(table.ratio_[i]);
+                if(table.ratio_[i]<ratio){
+                    ratio = std::nextafter(ratio, 0.0f);
+                }
+                table.ratiof_[i] = ratio;
+            }
+        }
+
+        struct ZigguratNormal
+        {
+            ZigguratNormal()
+            {
+                initializeZiggurat(table_, true, 3.6541528853610088, 0.00492867323399);
+            }
+            ZigguratTable table_;
+        };
+
+        struct ZigguratExponential
+        {
+            ZigguratExponential()
+            {
+                initializeZiggurat(table_, false, 7.69711747013104972, 0.0039496598225815571993);
+            }
+            ZigguratTable table_;
+        };
+    }
+
+    const ZigguratTable& getZigguratNormal()
+    {
+        static const ZigguratNormal normal;
+        return normal.table_;
+    }
+
+    const ZigguratTable& getZigguratExponential()
+    {
+        static const ZigguratExponential exponential;
+        return exponential.table_;
+    }
+
+    //----------------------------------------------------
+    const f64 PoissonDistribution::InversionLimit = 10.0;
+
+    PoissonDistribution::PoissonDistribution(f64 mean)
+        :mean_(mean)
+    {
+        LASSERT(0.0<=mean);
+        expMean_ = std::exp(-mean);
+        logMean_ = std::log(mean);
+        const f64 smu = std::sqrt(mean);
+        b_ = 0.931 + 2.53*smu;
+        a_ = -0.059 + 0.02483*b_;
+        logInvAlpha_ = std::log(1.1239 + 1.1328/(b_-3.4));
+        vr_ = 0.9277 - 3.6224/(b_-2.0);
+    }
+
+    //----------------------------------------------------
+    const f64 BinomialDistribution::InversionLimit = 10.0;
+
+    BinomialDistribution::BinomialDistribution(u64 n, f64 p)
+        :n_(n)
+        ,p_(p)
+    {
+        LASSERT(0.0<=p && p<=1.0);
+        flip_ = 0.5<p;
+        p = (flip_)? 1.0-p : p;
+        const f64 q = 1.0-p;
+        const f64 fn = static_cast<f64>(n);
+        useInversion_ = (fn*p)<InversionLimit;
+
+        q0_ = std::pow(q, fn);
+        s_ = p/q;
+        a_ = (fn+1.0)*s_;
+        b_ = c_ = vr_ = alpha_ = lpq_ = m_ = h_ = 0.0;
+        if(useInversion_){
+            return;
+        }
+        const f64 spq = std::sqrt(fn*p*q);
+        b_ = 1.15 + 2.53*spq;
+        a_ = -0.0873 + 0.0248*b_ + 0.01*p;
+        c_ = fn*p + 0.5;
+        vr_ = 0.92 - 4.2/b_;
+        alpha_ = (2.83 + 5.1/b_)*spq;
+        lpq_ = std::log(p/q);
+        m_ = std::floor((fn+1.0)*p);
+        h_ = std::lgamma(m_+1.0) + std::lgamma(fn-m_+1.0);
+    }
+
+    //----------------------------------------------------
+    GeometricDistribution::GeometricDistribution(f64 p)
+        :p_(p)
+    {
+        LASSERT(0.0<p && p<=1.0);
+        invLogQ_ = 1.0/std::log1p(-p);
+    }
+
+    //----------------------------------------------------
+    AliasTable::AliasTable()
+    {}
+
+    AliasTable::AliasTable(const f64* weights, u32 size)
+    {
+        initialize(weights, size);
+    }
+
+    void AliasTable::initialize(const f64* weights, u32 size)
+    {
+        LASSERT(NULL != weights && 0<size);
+        entries_.resize(size);
+        f64 total = 0.0;
+        for(u32 i=0; i<size; ++i){
+            LASSERT(0.0<=weights[i]);
+            total += weights[i];
+        }
+        LASSERT(0.0<total);
+
+        //Columns below and above the average, from both ends of one array
+        std::vector<f64> scaled(size);
+        std::vector<u32> work(size);
+        u32 small = 0;
+        u32 large = size;
+        const f64 scale = static_cast<f64>(size)/total;
+        for(u32 i=0; i<size; ++i){
+            scaled[i] = weights[i]*scale;
+            if(scaled[i]<1.0){
+                work[small++] = i;
+            }else{
+                work[--large] = i;
+            }
+        }
+        while(0<small && large<size){
+            const u32 s = work[--small];
+            const u32 l = work[large];
+            entries_[s].threshold_ = toThreshold(scaled[s]);
+            entries_[s].alias_ = l;
+            scaled[l] -= 1.0 - scaled[s];
+            if(scaled[l]<1.0){
+                //The large column moves to the small ones
+                ++large;
+                work[small++] = l;
+            }
+        }
+        //Left by rounding, they are full columns
+        for(u32 i=0; i<small; ++i){
+            entries_[work[i]].threshold_ = 0xFFFFFFFFU;
+            entries_[work[i]].alias_ = work[i];
+        }
+        for(u32 i=large; i<size; ++i){
+            entries_[work[i]].threshold_ = 0xFFFFFFFFU;
+            entries_[work[i]].alias_ = work[i];
+        }
+    }
+
+    u32 AliasTable::toThreshold(f64 probability)
+    {
+        const f64 threshold = probability*4294967296.0;
+        return (threshold<4294967295.0)? static_cast<u32>(threshold) : 0xFFFFFFFFU;
+    }
+}
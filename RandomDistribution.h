@@ -0,0 +1,581 @@
+#ifndef INC_RANDOMDISTRIBUTION_H_
+#define INC_RANDOMDISTRIBUTION_H_
+/**
+@file RandomDistribution.h
+@author t-sakai
+@date 2026/10/17 create
+
+Non-uniform distributions on the generators of Random.h.
+Parameters are prepared in constructors, so draws of the same distribution object repeat no setup.
+
+Normal and exponential values come from the ziggurat method of 256 layers.
+A value takes its layer from the lowest 8 bits, its sign from bit 8, and its position in the layer from the upper bits,
+and is accepted by one table lookup and one compare in about 99% of draws.
+The rest go through the wedge test or the tail, which draws more values from the generator.
+fill() runs the lookup and compare in kernels of RandomKernel.h over a block, then finishes the rejected values one by one,
+so it gives the same values on every instruction set.
+*/
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "Random.h"
+#include "RandomKernel.h"
+
+namespace lcore
+{
+    /**
+    @brief Layers of the ziggurat, layer 0 is the base strip with the tail
+    */
+    struct ZigguratTable
+    {
+        static const u32 Layers = 256;
+
+        inline f64 density(f64 x) const
+        {
+            return symmetric_? std::exp(-0.5*x*x) : std::exp(-x);
+        }
+
+        bool symmetric_; //!< Draw a sign, the normal distribution
+        u32 signMask32_; //!< Sign bit of f32 if symmetric, otherwise 0
+        u64 signMask64_; //!< Sign bit of f64 if symmetric, otherwise 0
+        f64 r_; //!< Start of the tail
+        f64 x_[Layers+1]; //!< Right edges of the layers, decreasing, x_[0] is the virtual width of the base
+        f64 ratio_[Layers]; //!< x_[i+1]/x_[i]
+        f64 f_[Layers+1]; //!< density(x_[i])
+        f32 xf_[Layers];
+        f32 ratiof_[Layers]; //!< ratio_ rounded down
+    };
+
+    const ZigguratTable& getZigguratNormal();
+    const ZigguratTable& getZigguratExponential();
+
+namespace detail
+{
+    /**
+    @brief Uniform in [0, 1) of 53 bits
+    */
+    template<class T>
+    inline f64 uniformRightOpen(T& random)
+    {
+        return static_cast<f64>(RandomBits<T>::rand64(random)>>11) * (1.0/9007199254740992.0);
+    }
+
+    /**
+    @brief Uniform in (0, 1] of 53 bits, for logarithms
+    */
+    template<class T>
+    inline f64 uniformLeftOpen(T& random)
+    {
+        return static_cast<f64>((RandomBits<T>::rand64(random)>>11) + 1) * (1.0/9007199254740992.0);
+    }
+
+    /**
+    @brief Finish a value which failed the rectangle test
+    @param value ... the candidate with its sign, and the result if accepted
+    @return false if rejected, and a new value should be drawn
+    */
+    template<class T>
+    bool zigguratReject(const ZigguratTable& table, T& random, u32 layer, f64& value)
+    {
+        if(0 == layer){
+            //Beyond the start of the tail
+            f64 x;
+            if(table.symmetric_){
+                f64 y;
+                do{
+                    x = -std::log(uniformLeftOpen(random)) / table.r_;
+                    y = -std::log(uniformLeftOpen(random));
+                }while((y+y)<(x*x));
+            }else{
+                x = -std::log(uniformLeftOpen(random));
+            }
+            x += table.r_;
+            value = (value<0.0)? -x : x;
+            return true;
+        }
+        //Wedge between the curve and the rectangle
+        const f64 u = uniformRightOpen(random);
+        const f64 y = table.f_[layer] + u*(table.f_[layer+1] - table.f_[layer]);
+        return y < table.density(value);
+    }
+
+    template<class T>
+    f64 zigguratDraw(const ZigguratTable& table, T& random)
+    {
+        for(;;){
+            const u64 bits = RandomBits<T>::rand64(random);
+            const u32 layer = static_cast<u32>(bits&0xFFU);
+            u64 ubits = (bits>>12) | 0x3FF0000000000000ULL;
+            f64 u;
+            memcpy(&u, &ubits, sizeof(f64));
+            u -= 1.0;
+            f64 value = u*table.x_[layer];
+            value = (table.symmetric_ && (bits&0x100U))? -value : value;
+            if(u<table.ratio_[layer] || zigguratReject(table, random, layer, value)){
+                return value;
+            }
+        }
+    }
+
+    template<class T>
+    void zigguratFill(const ZigguratTable& table, T& random, f32* out, size_t n)
+    {
+        static const size_t BlockSize = 1024;
+        const RandomKernels& kernels = getRandomKernels();
+        u32 bits[BlockSize];
+        u32 rejected[BlockSize];
+        while(0<n){
+            const size_t m = (BlockSize<n)? BlockSize : n;
+            RandomBits<T>::fill32(random, bits, m);
+            const size_t count = kernels.zigguratF32_(out, bits, m, table, rejected);
+            for(size_t i=0; i<count; ++i){
+                const u32 index = rejected[i];
+                f64 value = out[index];
+                if(!zigguratReject(table, random, bits[index]&0xFFU, value)){
+                    value = zigguratDraw(table, random);
+                }
+                out[index] = static_cast<f32>(value);
+            }
+            out += m;
+            n -= m;
+        }
+    }
+
+    template<class T>
+    void zigguratFill(const ZigguratTable& table, T& random, f64* out, size_t n)
+    {
+        static const size_t BlockSize = 512;
+        const RandomKernels& kernels = getRandomKernels();
+        u64 bits[BlockSize];
+        u32 rejected[BlockSize];
+        while(0<n){
+            const size_t m = (BlockSize<n)? BlockSize : n;
+            RandomBits<T>::fill64(random, bits, m);
+            const size_t count = kernels.zigguratF64_(out, bits, m, table, rejected);
+            for(size_t i=0; i<count; ++i){
+                const u32 index = rejected[i];
+                if(!zigguratReject(table, random, static_cast<u32>(bits[index]&0xFFU), out[index])){
+                    out[index] = zigguratDraw(table, random);
+                }
+            }
+            out += m;
+            n -= m;
+        }
+    }
+
+    template<class U>
+    void scaleValues(U* out, size_t n, U offset, U scale)
+    {
+        if(static_cast<U>(0) == offset && static_cast<U>(1) == scale){
+            return;
+        }
+        for(size_t i=0; i<n; ++i){
+            out[i] = offset + scale*out[i];
+        }
+    }
+}
+
+    //----------------------------------------------------
+    //---
+    //--- NormalDistribution
+    //---
+    //----------------------------------------------------
+    class NormalDistribution
+    {
+    public:
+        explicit NormalDistribution(f64 mean=0.0, f64 stddev=1.0)
+            :table_(&getZigguratNormal())
+            ,mean_(mean)
+            ,stddev_(stddev)
+        {}
+
+        f64 mean() const{ return mean_;}
+        f64 stddev() const{ return stddev_;}
+
+        template<class T>
+        f32 frand(T& random) const
+        {
+            return static_cast<f32>(drand(random));
+        }
+
+        template<class T>
+        f64 drand(T& random) const
+        {
+            return mean_ + stddev_*detail::zigguratDraw(*table_, random);
+        }
+
+        /**
+        @brief Fill a buffer, values come in a different order of the generator's output from frand
+        */
+        template<class T>
+        void fill(T& random, f32* out, size_t n) const
+        {
+            LASSERT(NULL != out || 0 == n);
+            detail::zigguratFill(*table_, random, out, n);
+            detail::scaleValues(out, n, static_cast<f32>(mean_), static_cast<f32>(stddev_));
+        }
+
+        /**
+        @brief Fill a buffer, values come in a different order of the generator's output from drand
+        */
+        template<class T>
+        void fill(T& random, f64* out, size_t n) const
+        {
+            LASSERT(NULL != out || 0 == n);
+            detail::zigguratFill(*table_, random, out, n);
+            detail::scaleValues(out, n, mean_, stddev_);
+        }
+
+    private:
+        const ZigguratTable* table_;
+        f64 mean_;
+        f64 stddev_;
+    };
+
+    //----------------------------------------------------
+    //---
+    //--- ExponentialDistribution
+    //---
+    //----------------------------------------------------
+    class ExponentialDistribution
+    {
+    public:
+        /**
+        @param lambda ... rate, the mean is 1/lambda
+        */
+        explicit ExponentialDistribution(f64 lambda=1.0)
+            :table_(&getZigguratExponential())
+            ,lambda_(lambda)
+        {
+            LASSERT(0.0<lambda);
+        }
+
+        f64 lambda() const{ return lambda_;}
+
+        template<class T>
+        f32 frand(T& random) const
+        {
+            return static_cast<f32>(drand(random));
+        }
+
+        template<class T>
+        f64 drand(T& random) const
+        {
+            return detail::zigguratDraw(*table_, random)/lambda_;
+        }
+
+        template<class T>
+        void fill(T& random, f32* out, size_t n) const
+        {
+            LASSERT(NULL != out || 0 == n);
+            detail::zigguratFill(*table_, random, out, n);
+            detail::scaleValues(out, n, 0.0f, static_cast<f32>(1.0/lambda_));
+        }
+
+        template<class T>
+        void fill(T& random, f64* out, size_t n) const
+        {
+            LASSERT(NULL != out || 0 == n);
+            detail::zigguratFill(*table_, random, out, n);
+            detail::scaleValues(out, n, 0.0, 1.0/lambda_);
+        }
+
+    private:
+        const ZigguratTable* table_;
+        f64 lambda_;
+    };
+
+    //----------------------------------------------------
+    //---
+    //--- PoissonDistribution
+    //---
+    //----------------------------------------------------
+    /**
+    @brief Poisson by inversion for means less than 10, and by Hormann's PTRS otherwise
+
+    PTRS is transformed rejection with squeeze, which accepts about 90% of draws without a logarithm,
+    so both take constant expected time.
+    */
+    class PoissonDistribution
+    {
+    public:
+        explicit PoissonDistribution(f64 mean=1.0);
+
+        f64 mean() const{ return mean_;}
+
+        template<class T>
+        u64 rand(T& random) const
+        {
+            return (mean_<InversionLimit)? inversion(random) : ptrs(random);
+        }
+
+        template<class T>
+        void fill(T& random, u64* out, size_t n) const
+        {
+            LASSERT(NULL != out || 0 == n);
+            for(size_t i=0; i<n; ++i){
+                out[i] = rand(random);
+            }
+        }
+
+    private:
+        static const f64 InversionLimit;
+
+        template<class T>
+        u64 inversion(T& random) const
+        {
+            f64 u = detail::uniformRightOpen(random);
+            f64 p = expMean_;
+            u64 k = 0;
+            while(p<=u){
+                u -= p;
+                ++k;
+                p *= mean_/static_cast<f64>(k);
+                if(p<=0.0){
+                    //Rounding left u above the total mass
+                    return k;
+                }
+            }
+            return k;
+        }
+
+        template<class T>
+        u64 ptrs(T& random) const
+        {
+            for(;;){
+                const f64 u = detail::uniformRightOpen(random) - 0.5;
+                const f64 v = detail::uniformLeftOpen(random);
+                const f64 us = 0.5 - std::fabs(u);
+                const f64 k = std::floor((2.0*a_/us + b_)*u + mean_ + 0.43);
+                if(0.07<=us && v<=vr_){
+                    return static_cast<u64>(k);
+                }
+                if(k<0.0 || (us<0.013 && us<v)){
+                    continue;
+                }
+                if((std::log(v) + logInvAlpha_ - std::log(a_/(us*us) + b_)) <= (-mean_ + k*logMean_ - std::lgamma(k+1.0))){
+                    return static_cast<u64>(k);
+                }
+            }
+        }
+
+        f64 mean_;
+        f64 expMean_; //!< exp(-mean)
+        f64 logMean_;
+        f64 a_;
+        f64 b_;
+        f64 logInvAlpha_;
+        f64 vr_;
+    };
+
+    //----------------------------------------------------
+    //---
+    //--- BinomialDistribution
+    //---
+    //----------------------------------------------------
+    /**
+    @brief Binomial by inversion for n*min(p, 1-p) less than 10, and by Hormann's BTRS otherwise
+
+    BTRS is the transformed rejection with squeeze of PTRS for binomials, in constant expected time.
+    p above 0.5 draws with 1-p and returns n minus the count.
+    */
+    class BinomialDistribution
+    {
+    public:
+        explicit BinomialDistribution(u64 n=1, f64 p=0.5);
+
+        u64 n() const{ return n_;}
+        f64 p() const{ return p_;}
+
+        template<class T>
+        u64 rand(T& random) const
+        {
+            const u64 k = (useInversion_)? inversion(random) : btrs(random);
+            return (flip_)? n_-k : k;
+        }
+
+        template<class T>
+        void fill(T& random, u64* out, size_t n) const
+        {
+            LASSERT(NULL != out || 0 == n);
+            for(size_t i=0; i<n; ++i){
+                out[i] = rand(random);
+            }
+        }
+
+    private:
+        static const f64 InversionLimit;
+
+        template<class T>
+        u64 inversion(T& random) const
+        {
+            f64 u = detail::uniformRightOpen(random);
+            f64 r = q0_;
+            u64 k = 0;
+            while(r<=u && k<n_){
+                u -= r;
+                ++k;
+                r *= a_/static_cast<f64>(k) - s_;
+            }
+            return k;
+        }
+
+        template<class T>
+        u64 btrs(T& random) const
+        {
+            const f64 n = static_cast<f64>(n_);
+            for(;;){
+                const f64 u = detail::uniformRightOpen(random) - 0.5;
+                const f64 v = detail::uniformLeftOpen(random);
+                const f64 us = 0.5 - std::fabs(u);
+                const f64 k = std::floor((2.0*a_/us + b_)*u + c_);
+                if(k<0.0 || n<k){
+                    continue;
+                }
+                if(0.07<=us && v<=vr_){
+                    return static_cast<u64>(k);
+                }
+                const f64 lv = std::log(v*alpha_/(a_/(us*us) + b_));
+                if(lv <= (h_ - std::lgamma(k+1.0) - std::lgamma(n-k+1.0) + (k-m_)*lpq_)){
+                    return static_cast<u64>(k);
+                }
+            }
+        }
+
+        u64 n_;
+        f64 p_;
+        bool flip_; //!< Draw with 1-p, and return n minus the count
+        bool useInversion_;
+        //Inversion
+        f64 q0_; //!< (1-p)^n
+        f64 s_; //!< p/(1-p)
+        //BTRS, a_ is (n+1)*s_ for inversion
+        f64 a_;
+        f64 b_;
+        f64 c_;
+        f64 vr_;
+        f64 alpha_;
+        f64 lpq_;
+        f64 m_;
+        f64 h_;
+    };
+
+    //----------------------------------------------------
+    //---
+    //--- GeometricDistribution
+    //---
+    //----------------------------------------------------
+    /**
+    @brief Number of failures before the first success, by inversion with one logarithm
+    */
+    class GeometricDistribution
+    {
+    public:
+        explicit GeometricDistribution(f64 p=0.5);
+
+        f64 p() const{ return p_;}
+
+        template<class T>
+        u64 rand(T& random) const
+        {
+            const f64 k = std::floor(std::log(detail::uniformLeftOpen(random)) * invLogQ_);
+            return (k<18446744073709551615.0)? static_cast<u64>(k) : 0xFFFFFFFFFFFFFFFFULL;
+        }
+
+        template<class T>
+        void fill(T& random, u64* out, size_t n) const
+        {
+            LASSERT(NULL != out || 0 == n);
+            for(size_t i=0; i<n; ++i){
+                out[i] = rand(random);
+            }
+        }
+
+    private:
+        f64 p_;
+        f64 invLogQ_; //!< 1/log(1-p)
+    };
+
+    //----------------------------------------------------
+    //---
+    //--- AliasTable
+    //---
+    //----------------------------------------------------
+    /**
+    @brief Indices in proportion to weights, by Walker's alias method with Vose's construction
+
+    A draw is one 64 bit value. Its product with size gives a column at the upper half,
+    and the lower half is compared with the 32 bit fixed point threshold of the column,
+    which keeps the column or takes its alias. A column is 8 bytes, so a draw touches one cache line.
+    */
+    class AliasTable
+    {
+    public:
+        struct Entry
+        {
+            u32 threshold_; //!< Keep the column if the fraction is less than threshold_/2^32
+            u32 alias_;
+        };
+
+        AliasTable();
+
+        /**
+        @param weights ... non-negative, and not all zero
+        @param size ...
+        */
+        AliasTable(const f64* weights, u32 size);
+
+        /**
+        @brief Build in O(size)
+        */
+        void initialize(const f64* weights, u32 size);
+
+        u32 size() const{ return static_cast<u32>(entries_.size());}
+        const Entry* entries() const{ return entries_.empty()? NULL : &entries_[0];}
+
+        template<class T>
+        u32 rand(T& random) const
+        {
+            LASSERT(!entries_.empty());
+            return select(RandomBits<T>::rand64(random));
+        }
+
+        /**
+        @brief Fill a buffer with indices of the same distribution as rand
+
+        The bits come from RandomBits<T>::fill64, so the indices differ from n calls of rand
+        for the generators whose bulk fill runs lanes, e.g. Xoshiro128Plus.
+        */
+        template<class T>
+        void fill(T& random, u32* out, size_t n) const
+        {
+            static const size_t BlockSize = 512;
+            LASSERT(!entries_.empty());
+            LASSERT(NULL != out || 0 == n);
+            u64 bits[BlockSize];
+            while(0<n){
+                const size_t m = (BlockSize<n)? BlockSize : n;
+                RandomBits<T>::fill64(random, bits, m);
+                for(size_t i=0; i<m; ++i){
+                    out[i] = select(bits[i]);
+                }
+                out += m;
+                n -= m;
+            }
+        }
+
+    private:
+        static u32 toThreshold(f64 probability);
+
+        inline u32 select(u64 bits) const
+        {
+            u64 fraction;
+            const u32 column = static_cast<u32>(mul64(bits, entries_.size(), fraction));
+            const Entry& entry = entries_[column];
+            return (static_cast<u32>(fraction>>32)<entry.threshold_)? column : entry.alias_;
+        }
+
+        std::vector<Entry> entries_;
+    };
+}
+#endif //INC_RANDOMDISTRIBUTION_H_
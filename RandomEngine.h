@@ -0,0 +1,426 @@
+#ifndef INC_RANDOMENGINE_H_
+#define INC_RANDOMENGINE_H_
+/**
+@file RandomEngine.h
+@author t-sakai
+@date 2026/10/17 create
+
+Header-only engines of the xoshiro and xoroshiro generators of Random.h, which callers' loops can inline.
+
+The word type, the state size and the shift constants are template parameters,
+and the typedefs give the same sequences as the classes of Random.h for the same seed,
+because those classes run the static step, generate and seedRandom of the typedefs on their states.
+Each engine is a uniform random bit generator of the standard library, so it works with <random> distributions and std::shuffle,
+and it has rand() for the helpers of Random.h.
+
+    Xoshiro128PlusEngine random(seed);
+    std::shuffle(values.begin(), values.end(), random);
+*/
+#include "Random.h"
+
+namespace lcore
+{
+namespace detail
+{
+    template<class U>
+    inline U rotlEngine(U x, s32 k)
+    {
+        return static_cast<U>((x << k) | (x >> (static_cast<s32>(8*sizeof(U)) - k)));
+    }
+
+    /**
+    @brief Same initial states as the default constructors of Random.h
+    */
+    inline u32 defaultEngineState(u32, u32 i)
+    {
+        static const u32 states[] = {123456789U, 362436069U, 521288629U, 88675123U};
+        return states[i&3];
+    }
+
+    inline u64 defaultEngineState(u64, u32 i)
+    {
+        static const u64 states[] = {123456789123456789ULL, 362436069362436069ULL, 521288629521288629ULL, 8867512388675123ULL};
+        return states[i&3];
+    }
+
+    /**
+    @brief Same seeding as srand of Random.h
+    */
+    inline void seedEngineState(u32* state, u32 n, u32 seed)
+    {
+        state[0] = seed;
+        for(u32 i=1; i<n; ++i){
+            state[i] = (1812433253 * (state[i-1]^(state[i-1] >> 30)) + i);
+        }
+    }
+
+    inline void seedEngineState(u64* state, u32 n, u64 seed)
+    {
+        state[0] = seed;
+        for(u32 i=1; i<n; ++i){
+            state[i] = (18124332531812433253ULL * (state[i-1]^(state[i-1] >> 60)) + i);
+        }
+    }
+
+    /**
+    @brief Linear step of xoshiro for a state of N words
+    */
+    template<u32 N>
+    struct XoshiroStep;
+
+    template<>
+    struct XoshiroStep<4>
+    {
+        template<class U, s32 A, s32 B>
+        static inline void next(U state[4])
+        {
+            const U t = state[1] << A;
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+
+            state[2] ^= t;
+
+            state[3] = rotlEngine(state[3], B);
+        }
+    };
+
+    template<>
+    struct XoshiroStep<8>
+    {
+        template<class U, s32 A, s32 B>
+        static inline void next(U state[8])
+        {
+            const U t = state[1] << A;
+
+            state[2] ^= state[0];
+            state[5] ^= state[1];
+            state[1] ^= state[2];
+            state[7] ^= state[3];
+            state[3] ^= state[4];
+            state[4] ^= state[5];
+            state[0] ^= state[6];
+            state[6] ^= state[7];
+
+            state[6] ^= t;
+
+            state[7] = rotlEngine(state[7], B);
+        }
+    };
+
+    /**
+    @brief Linear step of xoroshiro for a state of two words
+    */
+    template<class U, s32 A, s32 B, s32 C>
+    inline void xoroshiroStep(U state[2])
+    {
+        const U s0 = state[0];
+        U s1 = state[1];
+
+        s1 ^= s0;
+        state[0] = rotlEngine(s0, A) ^ s1 ^ (s1 << B);
+        state[1] = rotlEngine(s1, C);
+    }
+}
+
+    //---------------------------------------------
+    //---
+    //--- Scramblers
+    //---
+    //---------------------------------------------
+    /**
+    @brief Output of state[I] + state[J]
+    */
+    template<u32 I, u32 J>
+    struct EngineScramblerPlus
+    {
+        template<class U>
+        static inline U scramble(const U* state)
+        {
+            return static_cast<U>(state[I] + state[J]);
+        }
+    };
+
+    /**
+    @brief Output of rotl(state[I] + state[J], R) + state[I]
+    */
+    template<u32 I, u32 J, s32 R>
+    struct EngineScramblerPlusPlus
+    {
+        template<class U>
+        static inline U scramble(const U* state)
+        {
+            return static_cast<U>(detail::rotlEngine(static_cast<U>(state[I] + state[J]), R) + state[I]);
+        }
+    };
+
+    /**
+    @brief Output of rotl(state[I]*5, 7)*9
+    */
+    template<u32 I>
+    struct EngineScramblerStarStar
+    {
+        template<class U>
+        static inline U scramble(const U* state)
+        {
+            return static_cast<U>(detail::rotlEngine(static_cast<U>(state[I]*5), 7)*9);
+        }
+    };
+
+    //---------------------------------------------
+    //---
+    //--- Seedings
+    //---
+    //---------------------------------------------
+    /**
+    @brief The recurrence of srand of the older classes of Random.h
+    */
+    struct EngineSeedingRecurrence
+    {
+        template<class T, class U>
+        static inline void seed(T& random, U seed)
+        {
+            U state[T::StateSize];
+            detail::seedEngineState(state, T::StateSize, seed);
+            random.setState(state);
+        }
+    };
+
+    /**
+    @brief seedSplitMix64
+    */
+    struct EngineSeedingSplitMix64
+    {
+        template<class T, class U>
+        static inline void seed(T& random, U seed)
+        {
+            seedSplitMix64(random, seed);
+        }
+    };
+
+    //---------------------------------------------
+    //---
+    //--- XoshiroEngine
+    //---
+    //---------------------------------------------
+    /**
+    @brief xoshiro of N words of U, with the shift A and the rotation B of the linear step
+    */
+    template<class U, u32 N, s32 A, s32 B, class Scrambler, class Seeding=EngineSeedingRecurrence>
+    class XoshiroEngine
+    {
+    public:
+        typedef U result_type;
+        static const u32 StateSize = N;
+
+        static constexpr result_type min(){ return 0;}
+        static constexpr result_type max(){ return static_cast<result_type>(~static_cast<result_type>(0));}
+
+        XoshiroEngine()
+        {
+            for(u32 i=0; i<N; ++i){
+                state_[i] = detail::defaultEngineState(U(), i);
+            }
+        }
+
+        explicit XoshiroEngine(result_type seed)
+        {
+            srand(seed);
+        }
+
+        void srand(result_type seed)
+        {
+            seedRandom(*this, seed);
+        }
+
+        /**
+        @brief Set the state words, which should not be all zero, for seedMany
+        */
+        void setState(const U* state)
+        {
+            for(u32 i=0; i<N; ++i){
+                state_[i] = state[i];
+            }
+        }
+
+        void seed(result_type seed)
+        {
+            srand(seed);
+        }
+
+        inline result_type rand()
+        {
+            return generate(state_);
+        }
+
+        inline result_type operator()()
+        {
+            return rand();
+        }
+
+        /**
+        @brief Skip n outputs in O(n)
+        */
+        void discard(u64 n)
+        {
+            for(u64 i=0; i<n; ++i){
+                step(state_);
+            }
+        }
+
+        friend bool operator==(const XoshiroEngine& x0, const XoshiroEngine& x1)
+        {
+            for(u32 i=0; i<N; ++i){
+                if(x0.state_[i] != x1.state_[i]){
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend bool operator!=(const XoshiroEngine& x0, const XoshiroEngine& x1)
+        {
+            return !(x0 == x1);
+        }
+
+        //---------------------------------------------
+        //--- On a state of the class of Random.h of the same name, which shares the steps, scramblers and seeding
+        static inline void step(U state[N])
+        {
+            detail::XoshiroStep<N>::template next<U, A, B>(state);
+        }
+
+        static inline result_type generate(U state[N])
+        {
+            const result_type result = Scrambler::scramble(state);
+            step(state);
+            return result;
+        }
+
+        template<class T>
+        static inline void seedRandom(T& random, result_type seed)
+        {
+            Seeding::seed(random, seed);
+        }
+
+    private:
+        U state_[N];
+    };
+
+    //---------------------------------------------
+    //---
+    //--- XoroshiroEngine
+    //---
+    //---------------------------------------------
+    /**
+    @brief xoroshiro of two words of U, with the rotation A, the shift B and the rotation C of the linear step
+    */
+    template<class U, s32 A, s32 B, s32 C, class Scrambler>
+    class XoroshiroEngine
+    {
+    public:
+        typedef U result_type;
+        static const u32 StateSize = 2;
+
+        static constexpr result_type min(){ return 0;}
+        static constexpr result_type max(){ return static_cast<result_type>(~static_cast<result_type>(0));}
+
+        XoroshiroEngine()
+        {
+            state_[0] = detail::defaultEngineState(U(), 0);
+            state_[1] = detail::defaultEngineState(U(), 1);
+        }
+
+        explicit XoroshiroEngine(result_type seed)
+        {
+            srand(seed);
+        }
+
+        void srand(result_type seed)
+        {
+            seedRandom(*this, seed);
+        }
+
+        /**
+        @brief Set the state words, which should not be all zero, for seedMany
+        */
+        void setState(const U* state)
+        {
+            state_[0] = state[0];
+            state_[1] = state[1];
+        }
+
+        void seed(result_type seed)
+        {
+            srand(seed);
+        }
+
+        inline result_type rand()
+        {
+            return generate(state_);
+        }
+
+        inline result_type operator()()
+        {
+            return rand();
+        }
+
+        /**
+        @brief Skip n outputs in O(n)
+        */
+        void discard(u64 n)
+        {
+            for(u64 i=0; i<n; ++i){
+                step(state_);
+            }
+        }
+
+        friend bool operator==(const XoroshiroEngine& x0, const XoroshiroEngine& x1)
+        {
+            return x0.state_[0] == x1.state_[0] && x0.state_[1] == x1.state_[1];
+        }
+
+        friend bool operator!=(const XoroshiroEngine& x0, const XoroshiroEngine& x1)
+        {
+            return !(x0 == x1);
+        }
+
+        //---------------------------------------------
+        //--- On a state of the class of Random.h of the same name, which shares the steps, scramblers and seeding
+        static inline void step(U state[2])
+        {
+            detail::xoroshiroStep<U, A, B, C>(state);
+        }
+
+        static inline result_type generate(U state[2])
+        {
+            const result_type result = Scrambler::scramble(state);
+            step(state);
+            return result;
+        }
+
+        template<class T>
+        static inline void seedRandom(T& random, result_type seed)
+        {
+            EngineSeedingRecurrence::seed(random, seed);
+        }
+
+    private:
+        U state_[2];
+    };
+
+    //---------------------------------------------
+    /**
+    Same sequences as the classes of Random.h of the same names without Engine
+    */
+    typedef XoshiroEngine<u32, 4, 9, 11, EngineScramblerStarStar<0> > Xoshiro128StarEngine;
+    typedef XoshiroEngine<u32, 4, 9, 11, EngineScramblerPlus<0, 3> > Xoshiro128PlusEngine;
+    typedef XoshiroEngine<u32, 4, 9, 11, EngineScramblerPlusPlus<0, 3, 7>, EngineSeedingSplitMix64> Xoshiro128PlusPlusEngine;
+    typedef XoroshiroEngine<u64, 24, 16, 37, EngineScramblerPlus<0, 1> > Xoroshiro128PlusEngine;
+    typedef XoshiroEngine<u64, 4, 17, 45, EngineScramblerPlus<0, 3> > Xoroshiro256PlusEngine;
+    typedef XoshiroEngine<u64, 4, 17, 45, EngineScramblerStarStar<1>, EngineSeedingSplitMix64> Xoshiro256StarStarEngine;
+    typedef XoshiroEngine<u64, 8, 11, 21, EngineScramblerPlus<0, 2> > Xoroshiro512PlusEngine;
+}
+#endif //INC_RANDOMENGINE_H_
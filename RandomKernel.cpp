@@ -0,0 +1,278 @@
+/**
+@file RandomKernel.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "RandomKernelImpl.h"
+#include "RandomDistribution.h"
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define LCORE_RANDOM_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace lcore
+{
+    namespace
+    {
+#ifdef LCORE_RANDOM_X86
+        void cpuid(u32 info[4], u32 leaf, u32 subleaf)
+        {
+#if defined(_MSC_VER)
+            __cpuidex(reinterpret_cast<int*>(info), static_cast<int>(leaf), static_cast<int>(subleaf));
+#else
+            __cpuid_count(leaf, subleaf, info[0], info[1], info[2], info[3]);
+#endif
+        }
+
+        u64 xgetbv0()
+        {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            u32 eax, edx;
+            __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<u64>(edx)<<32) | eax;
+#endif
+        }
+
+        RandomISA detectISA()
+        {
+            u32 info[4];
+            cpuid(info, 0, 0);
+            const u32 maxLeaf = info[0];
+            if(maxLeaf<1){
+                return RandomISA_Scalar;
+            }
+            cpuid(info, 1, 0);
+            const u32 ecx1 = info[2];
+            if(0 == (ecx1 & (1U<<20))){
+                return RandomISA_Scalar;
+            }
+            RandomISA isa = RandomISA_SSE42;
+
+            //AVX, FMA and OS support of YMM registers, the AVX2 file is compiled with -mfma
+            const bool osxsave = 0 != (ecx1 & (1U<<27));
+            const bool avx = 0 != (ecx1 & (1U<<28));
+            const bool fma = 0 != (ecx1 & (1U<<12));
+            if(!osxsave || !avx || !fma || maxLeaf<7){
+                return isa;
+            }
+            const u64 xcr0 = xgetbv0();
+            if(0x06U != (xcr0 & 0x06U)){
+                return isa;
+            }
+            cpuid(info, 7, 0);
+            const u32 ebx7 = info[1];
+            if(0 == (ebx7 & (1U<<5))){
+                return isa;
+            }
+            isa = RandomISA_AVX2;
+
+            //AVX-512 F, DQ, BW, VL and OS support of ZMM registers
+            const u32 avx512 = (1U<<16) | (1U<<17) | (1U<<30) | (1U<<31);
+            if(avx512 == (ebx7 & avx512) && 0xE6U == (xcr0 & 0xE6U)){
+                isa = RandomISA_AVX512;
+            }
+            return isa;
+        }
+#else
+        RandomISA detectISA()
+        {
+            return RandomISA_Scalar;
+        }
+#endif
+
+        RandomISA getRequestedISA()
+        {
+            static const Char* names[] = {"scalar", "sse42", "avx2", "avx512"};
+#if defined(_MSC_VER)
+            Char value[16];
+            size_t length = 0;
+            if(0 != getenv_s(&length, value, sizeof(value), "LCORE_RANDOM_ISA") || length<=0){
+                return RandomISA_AVX512;
+            }
+#else
+            const Char* value = getenv("LCORE_RANDOM_ISA");
+            if(NULL == value){
+                return RandomISA_AVX512;
+            }
+#endif
+            for(u32 i=0; i<RandomISA_Num; ++i){
+                if(0 == strcmp(names[i], value)){
+                    return static_cast<RandomISA>(i);
+                }
+            }
+            return RandomISA_AVX512;
+        }
+
+        struct RandomKernelTable
+        {
+            RandomKernelTable()
+            {
+                RandomISA detected = detectISA();
+                RandomISA requested = getRequestedISA();
+                best_ = RandomISA_Scalar;
+
+                initRandomKernelsScalar(kernels_[RandomISA_Scalar]);
+                kernels_[RandomISA_Scalar].isa_ = RandomISA_Scalar;
+                for(u32 i=1; i<RandomISA_Num; ++i){
+                    kernels_[i] = kernels_[i-1];
+                    if(detected<i){
+                        continue;
+                    }
+                    bool compiled = false;
+                    switch(i)
+                    {
+                    case RandomISA_SSE42:
+                        compiled = initRandomKernelsSSE42(kernels_[i]);
+                        break;
+                    case RandomISA_AVX2:
+                        compiled = initRandomKernelsAVX2(kernels_[i]);
+                        break;
+                    case RandomISA_AVX512:
+                        compiled = initRandomKernelsAVX512(kernels_[i]);
+                        break;
+                    default:
+                        break;
+                    }
+                    if(compiled){
+                        kernels_[i].isa_ = static_cast<RandomISA>(i);
+                        if(i<=static_cast<u32>(requested)){
+                            best_ = static_cast<RandomISA>(i);
+                        }
+                    }
+                }
+            }
+
+            RandomISA best_;
+            RandomKernels kernels_[RandomISA_Num];
+        };
+
+        size_t zigguratF32(f32* out, const u32* bits, size_t n, const ZigguratTable& table, u32* rejected)
+        {
+            size_t count = 0;
+            for(size_t i=0; i<n; ++i){
+                const u32 layer = bits[i]&0xFFU;
+                const f32 u = static_cast<f32>(bits[i]>>9) * (1.0f/8388608.0f);
+                u32 x;
+                const f32 value = u*table.xf_[layer];
+                memcpy(&x, &value, sizeof(u32));
+                x ^= (bits[i]<<23) & table.signMask32_;
+                memcpy(out+i, &x, sizeof(u32));
+                rejected[count] = static_cast<u32>(i);
+                count += (u<table.ratiof_[layer])? 0 : 1;
+            }
+            return count;
+        }
+
+        size_t zigguratF64(f64* out, const u64* bits, size_t n, const ZigguratTable& table, u32* rejected)
+        {
+            size_t count = 0;
+            for(size_t i=0; i<n; ++i){
+                const u32 layer = static_cast<u32>(bits[i]&0xFFU);
+                u64 x = (bits[i]>>12) | 0x3FF0000000000000ULL;
+                f64 u;
+                memcpy(&u, &x, sizeof(f64));
+                u -= 1.0;
+                const f64 value = u*table.x_[layer];
+                memcpy(&x, &value, sizeof(u64));
+                x ^= (bits[i]<<55) & table.signMask64_;
+                memcpy(out+i, &x, sizeof(u64));
+                rejected[count] = static_cast<u32>(i);
+                count += (u<table.ratio_[layer])? 0 : 1;
+            }
+            return count;
+        }
+
+        void chacha20(u32* out, const u32 state[16], size_t blocks)
+        {
+            const u64 counter = getChaChaCounter(state);
+            for(size_t i=0; i<blocks; ++i){
+                chacha20Block(out + 16*i, state, counter+i);
+            }
+        }
+
+        void splitMix64(u64* out, u64 state, size_t n)
+        {
+            for(size_t i=0; i<n; ++i){
+                state += SplitMix64::Gamma;
+                out[i] = mixSplitMix64(state);
+            }
+        }
+
+        void philox4x32(u32* out, u64 key, u64 stream, u64 counter, size_t n)
+        {
+            for(size_t i=0; i<n; ++i){
+                philox4x32Block(out + 4*i, key, stream, counter+i);
+            }
+        }
+
+        void squares32(u32* out, u64 key, u64 counter, size_t n)
+        {
+            for(size_t i=0; i<n; ++i){
+                out[i] = squares32Value(counter+i, key);
+            }
+        }
+
+        const RandomKernelTable& getRandomKernelTable()
+        {
+            static const RandomKernelTable table;
+            return table;
+        }
+    }
+
+    RandomISA getRandomISA()
+    {
+        return getRandomKernelTable().best_;
+    }
+
+    const Char* getRandomISAName(RandomISA isa)
+    {
+        static const Char* names[] = {"Scalar", "SSE4.2", "AVX2", "AVX-512"};
+        return (isa<RandomISA_Num)? names[isa] : "Unknown";
+    }
+
+    const RandomKernels& getRandomKernels()
+    {
+        static const RandomKernels& kernels = getRandomKernels(getRandomISA());
+        return kernels;
+    }
+
+    const RandomKernels& getRandomKernels(RandomISA isa)
+    {
+        const RandomKernelTable& table = getRandomKernelTable();
+        return table.kernels_[(isa<RandomISA_Num)? isa : RandomISA_Scalar];
+    }
+
+    void initRandomKernelsScalar(RandomKernels& kernels)
+    {
+        initRandomKernels<PortableOps>(kernels);
+        //Kept by SSE4.2, replaced by AVX2, and AVX-512 keeps the AVX2 ones
+        kernels.zigguratF32_ = zigguratF32;
+        kernels.zigguratF64_ = zigguratF64;
+
+        kernels.toF32Full_0_ = convertLoopF32<toF32Full_0>;
+        kernels.toF32Full_1_ = convertLoopF32<toF32Full_1>;
+        kernels.toF64_0_ = convertLoopF64<toF64_0>;
+        kernels.toF64_1_ = convertLoopF64<toF64_1>;
+        kernels.toF64Full_0_ = convertLoopF64<toF64Full_0>;
+        kernels.toF64Full_1_ = convertLoopF64<toF64Full_1>;
+        kernels.pairToF64_0_ = convertLoopPairF64<toF64_0>;
+        kernels.pairToF64_1_ = convertLoopPairF64<toF64_1>;
+        kernels.pairToF64Full_0_ = convertLoopPairF64<toF64Full_0>;
+        kernels.pairToF64Full_1_ = convertLoopPairF64<toF64Full_1>;
+
+        kernels.chacha20_ = chacha20;
+        kernels.splitMix64_ = splitMix64;
+        kernels.philox4x32_ = philox4x32;
+        kernels.squares32_ = squares32;
+        kernels.mulHighU32_ = mulHighU32Loop;
+        kernels.feistel64_ = feistel64Loop;
+    }
+}
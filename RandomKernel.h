@@ -0,0 +1,151 @@
+#ifndef INC_RANDOMKERNEL_H_
+#define INC_RANDOMKERNEL_H_
+/**
+@file RandomKernel.h
+@author t-sakai
+@date 2026/10/17 create
+
+Bulk loops compiled for several instruction sets, selected once by cpuid.
+*/
+#include "Random.h"
+
+namespace lcore
+{
+    struct ZigguratTable;
+
+    enum RandomISA
+    {
+        RandomISA_Scalar = 0,
+        RandomISA_SSE42,
+        RandomISA_AVX2,
+        RandomISA_AVX512,
+        RandomISA_Num,
+    };
+
+    static const u32 RandomKernelLanes = 16;
+
+    struct RandomKernels
+    {
+        /**
+        @brief Run RandomKernelLanes interleaved xoshiro128 streams for blocks*RandomKernelLanes outputs
+        @param lanes ... lanes[i][k] is the i-th state word of lane k
+        */
+        typedef void (*FillLanesU32)(u32 (*lanes)[RandomKernelLanes], u32* out, size_t blocks);
+        typedef void (*FillLanesF32)(u32 (*lanes)[RandomKernelLanes], f32* out, size_t blocks);
+
+        /**
+        @brief Convert raw outputs to floats
+        */
+        typedef void (*ConvertF32)(f32* out, const u32* in, size_t n);
+        typedef void (*ConvertF64)(f64* out, const u64* in, size_t n);
+
+        /**
+        @brief Convert pairs of raw outputs to doubles, in[2i] is the upper half of out[i]
+        */
+        typedef void (*ConvertPairF64)(f64* out, const u32* in, size_t n);
+
+        /**
+        @brief Ziggurat candidates of bits and their rectangle tests
+        @param rejected ... indices of the candidates which failed
+        @return number of rejected
+        */
+        typedef size_t (*ZigguratF32)(f32* out, const u32* bits, size_t n, const ZigguratTable& table, u32* rejected);
+        typedef size_t (*ZigguratF64)(f64* out, const u64* bits, size_t n, const ZigguratTable& table, u32* rejected);
+
+        /**
+        @brief ChaCha20 blocks of the counters state[12] | state[13]<<32 + i, 16 words each
+        */
+        typedef void (*ChaCha20Blocks)(u32* out, const u32 state[16], size_t blocks);
+
+        /**
+        @brief SplitMix64 outputs of the states state + (i+1)*Gamma
+        */
+        typedef void (*SplitMix64Fill)(u64* out, u64 state, size_t n);
+
+        /**
+        @brief Philox4x32-10 of the counters (counter+i, stream), 4 words each
+        */
+        typedef void (*Philox4x32Blocks)(u32* out, u64 key, u64 stream, u64 counter, size_t n);
+
+        /**
+        @brief Squares32 of the counters counter+i, key already made by Squares32::makeKey
+        */
+        typedef void (*Squares32Fill)(u32* out, u64 key, u64 counter, size_t n);
+
+        /**
+        @brief out[i] = (bits[i]*range)>>32
+        @return non-zero if the lower half of any product is less than threshold
+        */
+        typedef u32 (*MulHighU32)(u32* out, const u32* bits, size_t n, u32 range, u32 threshold);
+
+        /**
+        @brief out[i] = in[i] encrypted by the Feistel network of RandomPermutation, out may be in
+        @param halfBits ... bits of each half of the network
+        */
+        typedef void (*Feistel64)(u64* out, const u64* in, size_t n, const u64* keys, u32 rounds, u32 halfBits);
+
+        RandomISA isa_;
+
+        FillLanesU32 xoshiro128PlusU32_;
+        FillLanesF32 xoshiro128PlusF32_0_; //!< (0, 1]
+        FillLanesF32 xoshiro128PlusF32_1_; //!< [0, 1)
+        FillLanesU32 xoshiro128StarU32_;
+        FillLanesF32 xoshiro128StarF32_0_; //!< (0, 1]
+        FillLanesF32 xoshiro128StarF32_1_; //!< [0, 1)
+
+        ConvertF32 toF32_0_; //!< (0, 1]
+        ConvertF32 toF32_1_; //!< [0, 1)
+
+        //Kept by SSE4.2, replaced by AVX2, and AVX-512 keeps the AVX2 ones
+        ConvertF32 toF32Full_0_; //!< (0, 1] of 24 bits
+        ConvertF32 toF32Full_1_; //!< [0, 1) of 24 bits
+        ConvertF64 toF64_0_; //!< (0, 1] of 52 bits
+        ConvertF64 toF64_1_; //!< [0, 1) of 52 bits
+        ConvertF64 toF64Full_0_; //!< (0, 1] of 53 bits
+        ConvertF64 toF64Full_1_; //!< [0, 1) of 53 bits
+        ConvertPairF64 pairToF64_0_;
+        ConvertPairF64 pairToF64_1_;
+        ConvertPairF64 pairToF64Full_0_;
+        ConvertPairF64 pairToF64Full_1_;
+
+        ZigguratF32 zigguratF32_;
+        ZigguratF64 zigguratF64_;
+
+        ChaCha20Blocks chacha20_;
+
+        SplitMix64Fill splitMix64_; //!< Replaced by AVX2 and AVX-512
+
+        Philox4x32Blocks philox4x32_;
+        Squares32Fill squares32_;
+
+        MulHighU32 mulHighU32_; //!< Replaced by AVX2 and AVX-512
+        Feistel64 feistel64_; //!< Replaced by AVX2 and AVX-512
+    };
+
+    /**
+    @brief The best instruction set supported by both of this binary and the CPU
+
+    The environment variable LCORE_RANDOM_ISA (scalar, sse42, avx2, avx512) caps the result.
+    */
+    RandomISA getRandomISA();
+
+    const Char* getRandomISAName(RandomISA isa);
+
+    /**
+    @brief Kernels for getRandomISA(), selected on the first call
+    */
+    const RandomKernels& getRandomKernels();
+
+    /**
+    @brief Kernels for isa, falling back to the best supported set below it
+    */
+    const RandomKernels& getRandomKernels(RandomISA isa);
+
+    //--- Per instruction set initializers, return false if not compiled in.
+    void initRandomKernelsScalar(RandomKernels& kernels);
+    bool initRandomKernelsSSE42(RandomKernels& kernels);
+    bool initRandomKernelsAVX2(RandomKernels& kernels);
+    bool initRandomKernelsAVX512(RandomKernels& kernels);
+}
+
+#endif //INC_RANDOMKERNEL_H_
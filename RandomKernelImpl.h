@@ -0,0 +1,413 @@
+#ifndef INC_RANDOMKERNELIMPL_H_
+#define INC_RANDOMKERNELIMPL_H_
+/**
+@file RandomKernelImpl.h
+@author t-sakai
+@date 2026/10/17 create
+
+Kernel bodies shared by RandomKernel*.cpp, included only from those files.
+Each file instantiates them with its own vector operations.
+Everything here has internal linkage, so copies compiled with different instruction sets never merge at link time.
+*/
+#include <cstring>
+#include "RandomKernel.h"
+#include "RandomCounter.h"
+
+namespace lcore
+{
+namespace
+{
+    /**
+    @brief Vector operations of width 1
+    */
+    struct ScalarOps
+    {
+        typedef u32 type;
+        static const u32 Width = 1;
+
+        static inline type load(const u32* p){ return *p;}
+        static inline void store(u32* p, type x){ *p = x;}
+        static inline void storeF32_0(f32* p, type x)
+        {
+            x = 0x3F800000U | (x&0x007FFFFFU);
+            f32 f;
+            memcpy(&f, &x, sizeof(f32));
+            *p = f - 0.999999881f;
+        }
+        static inline void storeF32_1(f32* p, type x)
+        {
+            x = 0x3F800000U | (x&0x007FFFFFU);
+            f32 f;
+            memcpy(&f, &x, sizeof(f32));
+            *p = f - 1.000000000f;
+        }
+        static inline type add(type a, type b){ return a+b;}
+        static inline type bxor(type a, type b){ return a^b;}
+        static inline type shl(type x, s32 k){ return x<<k;}
+        static inline type rotl(type x, s32 k){ return (x<<k) | (x>>(32-k));}
+    };
+
+    /**
+    @brief Vector operations over all lanes in plain loops, left to the auto-vectorizer
+    */
+    struct PortableOps
+    {
+        struct type
+        {
+            u32 v_[RandomKernelLanes];
+        };
+        static const u32 Width = RandomKernelLanes;
+
+        static inline type load(const u32* p)
+        {
+            type r;
+            memcpy(r.v_, p, sizeof(type));
+            return r;
+        }
+        static inline void store(u32* p, const type& x)
+        {
+            memcpy(p, x.v_, sizeof(type));
+        }
+        static inline void storeF32_0(f32* p, const type& x)
+        {
+            for(u32 i=0; i<Width; ++i){
+                ScalarOps::storeF32_0(p+i, x.v_[i]);
+            }
+        }
+        static inline void storeF32_1(f32* p, const type& x)
+        {
+            for(u32 i=0; i<Width; ++i){
+                ScalarOps::storeF32_1(p+i, x.v_[i]);
+            }
+        }
+        static inline type add(const type& a, const type& b)
+        {
+            type r;
+            for(u32 i=0; i<Width; ++i){
+                r.v_[i] = a.v_[i] + b.v_[i];
+            }
+            return r;
+        }
+        static inline type bxor(const type& a, const type& b)
+        {
+            type r;
+            for(u32 i=0; i<Width; ++i){
+                r.v_[i] = a.v_[i] ^ b.v_[i];
+            }
+            return r;
+        }
+        static inline type shl(const type& x, s32 k)
+        {
+            type r;
+            for(u32 i=0; i<Width; ++i){
+                r.v_[i] = x.v_[i] << k;
+            }
+            return r;
+        }
+        static inline type rotl(const type& x, s32 k)
+        {
+            type r;
+            for(u32 i=0; i<Width; ++i){
+                r.v_[i] = (x.v_[i] << k) | (x.v_[i] >> (32-k));
+            }
+            return r;
+        }
+    };
+
+    //---------------------------------------------
+    template<class V>
+    struct Xoshiro128PlusOp
+    {
+        typedef typename V::type type;
+        static inline type scramble(type s0, type s3)
+        {
+            return V::add(s0, s3);
+        }
+    };
+
+    template<class V>
+    struct Xoshiro128StarOp
+    {
+        typedef typename V::type type;
+        static inline type scramble(type s0, type)
+        {
+            type x = V::add(s0, V::shl(s0, 2)); //s0*5
+            x = V::rotl(x, 7);
+            return V::add(x, V::shl(x, 3)); //x*9
+        }
+    };
+
+    template<class V>
+    struct StoreU32Op
+    {
+        typedef u32 value_type;
+        static inline void store(u32* p, typename V::type x){ V::store(p, x);}
+    };
+
+    template<class V>
+    struct StoreF32_0Op
+    {
+        typedef f32 value_type;
+        static inline void store(f32* p, typename V::type x){ V::storeF32_0(p, x);}
+    };
+
+    template<class V>
+    struct StoreF32_1Op
+    {
+        typedef f32 value_type;
+        static inline void store(f32* p, typename V::type x){ V::storeF32_1(p, x);}
+    };
+
+    //---------------------------------------------
+    template<class V, template<class> class Scrambler, template<class> class Store>
+    void fillLanesXoshiro128(u32 (*lanes)[RandomKernelLanes], typename Store<V>::value_type* out, size_t blocks)
+    {
+        typedef typename V::type type;
+
+        //Lanes are independent, so run each group of V::Width lanes through all blocks while it stays in registers.
+        for(u32 g=0; g<RandomKernelLanes; g+=V::Width){
+            type s0 = V::load(lanes[0] + g);
+            type s1 = V::load(lanes[1] + g);
+            type s2 = V::load(lanes[2] + g);
+            type s3 = V::load(lanes[3] + g);
+            typename Store<V>::value_type* o = out + g;
+            for(size_t j=0; j<blocks; ++j){
+                Store<V>::store(o, Scrambler<V>::scramble(s0, s3));
+
+                const type t = V::shl(s1, 9);
+                s2 = V::bxor(s2, s0);
+                s3 = V::bxor(s3, s1);
+                s1 = V::bxor(s1, s2);
+                s0 = V::bxor(s0, s3);
+                s2 = V::bxor(s2, t);
+                s3 = V::rotl(s3, 11);
+                o += RandomKernelLanes;
+            }
+            V::store(lanes[0] + g, s0);
+            V::store(lanes[1] + g, s1);
+            V::store(lanes[2] + g, s2);
+            V::store(lanes[3] + g, s3);
+        }
+    }
+
+    template<class V, template<class> class Store>
+    void convertF32(f32* out, const u32* in, size_t n)
+    {
+        size_t i = 0;
+        for(; (i+V::Width)<=n; i+=V::Width){
+            Store<V>::store(out+i, V::load(in+i));
+        }
+        for(; i<n; ++i){
+            Store<ScalarOps>::store(out+i, in[i]);
+        }
+    }
+
+    //---------------------------------------------
+    //--- Conversions of one value, also the tails of the SIMD conversions, so every instruction set gives the same values
+    inline f32 toF32Full_0(u32 x)
+    {
+        return static_cast<f32>((x>>8) + 1) * (1.0f/16777216.0f);
+    }
+
+    inline f32 toF32Full_1(u32 x)
+    {
+        return static_cast<f32>(x>>8) * (1.0f/16777216.0f);
+    }
+
+    inline f64 toF64_1(u64 x)
+    {
+        x = 0x3FF0000000000000ULL | (x>>12);
+        f64 d;
+        memcpy(&d, &x, sizeof(f64));
+        return d - 1.0;
+    }
+
+    inline f64 toF64_0(u64 x)
+    {
+        x = 0x3FF0000000000000ULL | (x>>12);
+        f64 d;
+        memcpy(&d, &x, sizeof(f64));
+        return 2.0 - d;
+    }
+
+    inline f64 toF64Full_0(u64 x)
+    {
+        return static_cast<f64>((x>>11) + 1) * (1.0/9007199254740992.0);
+    }
+
+    inline f64 toF64Full_1(u64 x)
+    {
+        return static_cast<f64>(x>>11) * (1.0/9007199254740992.0);
+    }
+
+    inline u64 toPair(const u32* in)
+    {
+        return (static_cast<u64>(in[0])<<32) | in[1];
+    }
+
+    //---------------------------------------------
+    //--- ChaCha20, also the tail of the SIMD blocks
+    inline u32 rotlChaCha(u32 x, s32 k)
+    {
+        return (x<<k) | (x>>(32-k));
+    }
+
+    inline void quarterRoundChaCha(u32& a, u32& b, u32& c, u32& d)
+    {
+        a += b; d ^= a; d = rotlChaCha(d, 16);
+        c += d; b ^= c; b = rotlChaCha(b, 12);
+        a += b; d ^= a; d = rotlChaCha(d, 8);
+        c += d; b ^= c; b = rotlChaCha(b, 7);
+    }
+
+    inline void chacha20Block(u32* out, const u32 state[16], u64 counter)
+    {
+        u32 input[16];
+        for(u32 i=0; i<16; ++i){
+            input[i] = state[i];
+        }
+        input[12] = static_cast<u32>(counter);
+        input[13] = static_cast<u32>(counter>>32);
+
+        u32 x[16];
+        for(u32 i=0; i<16; ++i){
+            x[i] = input[i];
+        }
+        for(u32 i=0; i<10; ++i){
+            quarterRoundChaCha(x[0], x[4], x[8], x[12]);
+            quarterRoundChaCha(x[1], x[5], x[9], x[13]);
+            quarterRoundChaCha(x[2], x[6], x[10], x[14]);
+            quarterRoundChaCha(x[3], x[7], x[11], x[15]);
+            quarterRoundChaCha(x[0], x[5], x[10], x[15]);
+            quarterRoundChaCha(x[1], x[6], x[11], x[12]);
+            quarterRoundChaCha(x[2], x[7], x[8], x[13]);
+            quarterRoundChaCha(x[3], x[4], x[9], x[14]);
+        }
+        for(u32 i=0; i<16; ++i){
+            out[i] = x[i] + input[i];
+        }
+    }
+
+    inline u64 getChaChaCounter(const u32 state[16])
+    {
+        return (static_cast<u64>(state[13])<<32) | state[12];
+    }
+
+    //---------------------------------------------
+    //--- SplitMix64, Philox4x32 and Squares32, also the tails of the SIMD kernels
+    //--- Copies of the inline functions of Random.h and RandomCounter.h, so that no copy compiled with wider instructions is shared by the linker
+    inline u64 mixSplitMix64(u64 z)
+    {
+        z = (z ^ (z>>30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z>>27)) * 0x94D049BB133111EBULL;
+        return z ^ (z>>31);
+    }
+
+    inline void philox4x32Block(u32 out[4], u64 key, u64 stream, u64 counter)
+    {
+        u32 c0 = static_cast<u32>(counter), c1 = static_cast<u32>(counter>>32);
+        u32 c2 = static_cast<u32>(stream), c3 = static_cast<u32>(stream>>32);
+        u32 k0 = static_cast<u32>(key), k1 = static_cast<u32>(key>>32);
+        for(u32 i=0; i<Philox4x32::Rounds; ++i){
+            const u64 p0 = static_cast<u64>(Philox4x32::M0)*c0;
+            const u64 p1 = static_cast<u64>(Philox4x32::M1)*c2;
+            c0 = static_cast<u32>(p1>>32) ^ c1 ^ k0;
+            c1 = static_cast<u32>(p1);
+            c2 = static_cast<u32>(p0>>32) ^ c3 ^ k1;
+            c3 = static_cast<u32>(p0);
+            k0 += Philox4x32::W0;
+            k1 += Philox4x32::W1;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    inline u32 squares32Value(u64 counter, u64 key)
+    {
+        u64 x = counter*key;
+        const u64 y = x;
+        const u64 z = y + key;
+        x = x*x + y; x = (x>>32) | (x<<32);
+        x = x*x + z; x = (x>>32) | (x<<32);
+        x = x*x + y; x = (x>>32) | (x<<32);
+        return static_cast<u32>((x*x + z)>>32);
+    }
+
+    //---------------------------------------------
+    //--- Multiply-shift of bounded values, also the tail of the SIMD kernels
+    inline u32 mulHighU32Loop(u32* out, const u32* bits, size_t n, u32 range, u32 threshold)
+    {
+        u32 rejected = 0;
+        for(size_t i=0; i<n; ++i){
+            const u64 m = static_cast<u64>(bits[i]) * range;
+            out[i] = static_cast<u32>(m>>32);
+            rejected |= (static_cast<u32>(m)<threshold)? 1U : 0U;
+        }
+        return rejected;
+    }
+
+    //---------------------------------------------
+    //--- Feistel network of RandomPermutation, also the tail of the SIMD kernels
+    inline u64 feistel64Value(u64 x, const u64* keys, u32 rounds, u32 halfBits)
+    {
+        const u64 halfMask = (1ULL<<halfBits) - 1;
+        u64 left = x>>halfBits;
+        u64 right = x&halfMask;
+        for(u32 i=0; i<rounds; ++i){
+            const u64 next = left ^ (mixSplitMix64(right ^ keys[i])&halfMask);
+            left = right;
+            right = next;
+        }
+        return (left<<halfBits) | right;
+    }
+
+    inline void feistel64Loop(u64* out, const u64* in, size_t n, const u64* keys, u32 rounds, u32 halfBits)
+    {
+        for(size_t i=0; i<n; ++i){
+            out[i] = feistel64Value(in[i], keys, rounds, halfBits);
+        }
+    }
+
+    template<f32 (*Convert)(u32)>
+    void convertLoopF32(f32* out, const u32* in, size_t n)
+    {
+        for(size_t i=0; i<n; ++i){
+            out[i] = Convert(in[i]);
+        }
+    }
+
+    template<f64 (*Convert)(u64)>
+    void convertLoopF64(f64* out, const u64* in, size_t n)
+    {
+        for(size_t i=0; i<n; ++i){
+            out[i] = Convert(in[i]);
+        }
+    }
+
+    template<f64 (*Convert)(u64)>
+    void convertLoopPairF64(f64* out, const u32* in, size_t n)
+    {
+        for(size_t i=0; i<n; ++i){
+            out[i] = Convert(toPair(in + 2*i));
+        }
+    }
+
+    template<class V>
+    void initRandomKernels(RandomKernels& kernels)
+    {
+        kernels.xoshiro128PlusU32_ = fillLanesXoshiro128<V, Xoshiro128PlusOp, StoreU32Op>;
+        kernels.xoshiro128PlusF32_0_ = fillLanesXoshiro128<V, Xoshiro128PlusOp, StoreF32_0Op>;
+        kernels.xoshiro128PlusF32_1_ = fillLanesXoshiro128<V, Xoshiro128PlusOp, StoreF32_1Op>;
+        kernels.xoshiro128StarU32_ = fillLanesXoshiro128<V, Xoshiro128StarOp, StoreU32Op>;
+        kernels.xoshiro128StarF32_0_ = fillLanesXoshiro128<V, Xoshiro128StarOp, StoreF32_0Op>;
+        kernels.xoshiro128StarF32_1_ = fillLanesXoshiro128<V, Xoshiro128StarOp, StoreF32_1Op>;
+
+        kernels.toF32_0_ = convertF32<V, StoreF32_0Op>;
+        kernels.toF32_1_ = convertF32<V, StoreF32_1Op>;
+    }
+}
+}
+
+#endif //INC_RANDOMKERNELIMPL_H_
@@ -0,0 +1,577 @@
+/**
+@file RandomKernel_AVX2.cpp
+@author t-sakai
+@date 2026/10/17 create
+
+Compiled with AVX2 enabled.
+*/
+#include "RandomKernelImpl.h"
+#include "RandomDistribution.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+
+namespace lcore
+{
+    namespace
+    {
+        struct AVX2Ops
+        {
+            typedef __m256i type;
+            static const u32 Width = 8;
+
+            static inline type load(const u32* p){ return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));}
+            static inline void store(u32* p, type x){ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x);}
+            static inline void storeF32_0(f32* p, type x)
+            {
+                x = _mm256_or_si256(_mm256_and_si256(x, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000));
+                _mm256_storeu_ps(p, _mm256_sub_ps(_mm256_castsi256_ps(x), _mm256_set1_ps(0.999999881f)));
+            }
+            static inline void storeF32_1(f32* p, type x)
+            {
+                x = _mm256_or_si256(_mm256_and_si256(x, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000));
+                _mm256_storeu_ps(p, _mm256_sub_ps(_mm256_castsi256_ps(x), _mm256_set1_ps(1.0f)));
+            }
+            static inline type add(type a, type b){ return _mm256_add_epi32(a, b);}
+            static inline type bxor(type a, type b){ return _mm256_xor_si256(a, b);}
+            static inline type shl(type x, s32 k){ return _mm256_slli_epi32(x, k);}
+            static inline type rotl(type x, s32 k){ return _mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 32-k));}
+        };
+
+        /**
+        @brief Append i+k of the lanes k not set in accepted
+        */
+        inline size_t appendRejected(u32* rejected, size_t count, size_t i, s32 accepted, s32 lanes)
+        {
+            for(s32 k=0; k<lanes; ++k){
+                rejected[count] = static_cast<u32>(i+k);
+                count += ((accepted>>k)&1)? 0 : 1;
+            }
+            return count;
+        }
+
+        size_t zigguratF32(f32* out, const u32* bits, size_t n, const ZigguratTable& table, u32* rejected)
+        {
+            const __m256i layerMask = _mm256_set1_epi32(0xFF);
+            const __m256i signMask = _mm256_set1_epi32(static_cast<s32>(table.signMask32_));
+            const __m256 scale = _mm256_set1_ps(1.0f/8388608.0f);
+            size_t count = 0;
+            size_t i = 0;
+            for(; (i+8)<=n; i+=8){
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits+i));
+                const __m256i layer = _mm256_and_si256(b, layerMask);
+                const __m256 u = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(b, 9)), scale);
+                const __m256 x = _mm256_i32gather_ps(table.xf_, layer, 4);
+                const __m256 ratio = _mm256_i32gather_ps(table.ratiof_, layer, 4);
+                const __m256i sign = _mm256_and_si256(_mm256_slli_epi32(b, 23), signMask);
+                const __m256 value = _mm256_castsi256_ps(_mm256_xor_si256(_mm256_castps_si256(_mm256_mul_ps(u, x)), sign));
+                _mm256_storeu_ps(out+i, value);
+                const s32 accepted = _mm256_movemask_ps(_mm256_cmp_ps(u, ratio, _CMP_LT_OQ));
+                if(0xFF != accepted){
+                    count = appendRejected(rejected, count, i, accepted, 8);
+                }
+            }
+            for(; i<n; ++i){
+                const u32 layer = bits[i]&0xFFU;
+                const f32 u = static_cast<f32>(bits[i]>>9) * (1.0f/8388608.0f);
+                u32 x;
+                const f32 value = u*table.xf_[layer];
+                memcpy(&x, &value, sizeof(u32));
+                x ^= (bits[i]<<23) & table.signMask32_;
+                memcpy(out+i, &x, sizeof(u32));
+                rejected[count] = static_cast<u32>(i);
+                count += (u<table.ratiof_[layer])? 0 : 1;
+            }
+            return count;
+        }
+
+        size_t zigguratF64(f64* out, const u64* bits, size_t n, const ZigguratTable& table, u32* rejected)
+        {
+            const __m256i layerMask = _mm256_set1_epi64x(0xFF);
+            const __m256i signMask = _mm256_set1_epi64x(static_cast<s64>(table.signMask64_));
+            const __m256i one = _mm256_set1_epi64x(0x3FF0000000000000LL);
+            size_t count = 0;
+            size_t i = 0;
+            for(; (i+4)<=n; i+=4){
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits+i));
+                const __m256i layer = _mm256_and_si256(b, layerMask);
+                const __m256d u = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(b, 12), one)), _mm256_set1_pd(1.0));
+                const __m256d x = _mm256_i64gather_pd(table.x_, layer, 8);
+                const __m256d ratio = _mm256_i64gather_pd(table.ratio_, layer, 8);
+                const __m256i sign = _mm256_and_si256(_mm256_slli_epi64(b, 55), signMask);
+                const __m256d value = _mm256_castsi256_pd(_mm256_xor_si256(_mm256_castpd_si256(_mm256_mul_pd(u, x)), sign));
+                _mm256_storeu_pd(out+i, value);
+                const s32 accepted = _mm256_movemask_pd(_mm256_cmp_pd(u, ratio, _CMP_LT_OQ));
+                if(0xF != accepted){
+                    count = appendRejected(rejected, count, i, accepted, 4);
+                }
+            }
+            for(; i<n; ++i){
+                const u32 layer = static_cast<u32>(bits[i]&0xFFU);
+                u64 x = (bits[i]>>12) | 0x3FF0000000000000ULL;
+                f64 u;
+                memcpy(&u, &x, sizeof(f64));
+                u -= 1.0;
+                const f64 value = u*table.x_[layer];
+                memcpy(&x, &value, sizeof(u64));
+                x ^= (bits[i]<<55) & table.signMask64_;
+                memcpy(out+i, &x, sizeof(u64));
+                rejected[count] = static_cast<u32>(i);
+                count += (u<table.ratio_[layer])? 0 : 1;
+            }
+            return count;
+        }
+    }
+
+    namespace
+    {
+        //Same values as the scalar conversions of RandomKernelImpl.h, all of which are exact
+        struct ToF32Full_0
+        {
+            static inline __m256 convert(__m256i x)
+            {
+                x = _mm256_add_epi32(_mm256_srli_epi32(x, 8), _mm256_set1_epi32(1));
+                return _mm256_mul_ps(_mm256_cvtepi32_ps(x), _mm256_set1_ps(1.0f/16777216.0f));
+            }
+            static inline f32 convert(u32 x){ return toF32Full_0(x);}
+        };
+
+        struct ToF32Full_1
+        {
+            static inline __m256 convert(__m256i x)
+            {
+                return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(x, 8)), _mm256_set1_ps(1.0f/16777216.0f));
+            }
+            static inline f32 convert(u32 x){ return toF32Full_1(x);}
+        };
+
+        inline __m256d toF64_1(__m256i x)
+        {
+            x = _mm256_or_si256(_mm256_srli_epi64(x, 12), _mm256_set1_epi64x(0x3FF0000000000000LL));
+            return _mm256_sub_pd(_mm256_castsi256_pd(x), _mm256_set1_pd(1.0));
+        }
+
+        /**
+        @brief 53 bits without a conversion of 64 bit integers, the 52 bits of toF64_1 and 2^-53 for bit 11
+        */
+        inline __m256d toF64Full_1(__m256i x)
+        {
+            const __m256i bit = _mm256_set1_epi64x(0x800);
+            const __m256i half = _mm256_cmpeq_epi64(_mm256_and_si256(x, bit), bit);
+            const __m256d ulp = _mm256_castsi256_pd(_mm256_and_si256(half, _mm256_castpd_si256(_mm256_set1_pd(1.0/9007199254740992.0))));
+            return _mm256_add_pd(toF64_1(x), ulp);
+        }
+
+        struct ToF64_0
+        {
+            static inline __m256d convert(__m256i x)
+            {
+                x = _mm256_or_si256(_mm256_srli_epi64(x, 12), _mm256_set1_epi64x(0x3FF0000000000000LL));
+                return _mm256_sub_pd(_mm256_set1_pd(2.0), _mm256_castsi256_pd(x));
+            }
+            static inline f64 convert(u64 x){ return lcore::toF64_0(x);}
+        };
+
+        struct ToF64_1
+        {
+            static inline __m256d convert(__m256i x){ return toF64_1(x);}
+            static inline f64 convert(u64 x){ return lcore::toF64_1(x);}
+        };
+
+        struct ToF64Full_0
+        {
+            static inline __m256d convert(__m256i x)
+            {
+                return _mm256_add_pd(toF64Full_1(x), _mm256_set1_pd(1.0/9007199254740992.0));
+            }
+            static inline f64 convert(u64 x){ return lcore::toF64Full_0(x);}
+        };
+
+        struct ToF64Full_1
+        {
+            static inline __m256d convert(__m256i x){ return toF64Full_1(x);}
+            static inline f64 convert(u64 x){ return lcore::toF64Full_1(x);}
+        };
+
+        template<class Op>
+        void convertF32(f32* out, const u32* in, size_t n)
+        {
+            size_t i = 0;
+            for(; (i+8)<=n; i+=8){
+                _mm256_storeu_ps(out+i, Op::convert(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in+i))));
+            }
+            for(; i<n; ++i){
+                out[i] = Op::convert(in[i]);
+            }
+        }
+
+        template<class Op>
+        void convertF64(f64* out, const u64* in, size_t n)
+        {
+            size_t i = 0;
+            for(; (i+4)<=n; i+=4){
+                _mm256_storeu_pd(out+i, Op::convert(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in+i))));
+            }
+            for(; i<n; ++i){
+                out[i] = Op::convert(in[i]);
+            }
+        }
+
+        /**
+        @brief The pairs load as low then high, so swap the halves of each 64 bit lane
+        */
+        template<class Op>
+        void convertPairF64(f64* out, const u32* in, size_t n)
+        {
+            size_t i = 0;
+            for(; (i+4)<=n; i+=4){
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in+2*i));
+                _mm256_storeu_pd(out+i, Op::convert(_mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1))));
+            }
+            for(; i<n; ++i){
+                out[i] = Op::convert(toPair(in+2*i));
+            }
+        }
+    }
+
+    namespace
+    {
+        inline __m256i rotlChaCha(__m256i x, s32 k)
+        {
+            return _mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 32-k));
+        }
+
+        inline void quarterRoundChaCha(__m256i& a, __m256i& b, __m256i& c, __m256i& d)
+        {
+            //Rotations by 16 and 8 are byte shuffles
+            const __m256i rotl16 = _mm256_setr_epi8(2,3,0,1, 6,7,4,5, 10,11,8,9, 14,15,12,13, 2,3,0,1, 6,7,4,5, 10,11,8,9, 14,15,12,13);
+            const __m256i rotl8 = _mm256_setr_epi8(3,0,1,2, 7,4,5,6, 11,8,9,10, 15,12,13,14, 3,0,1,2, 7,4,5,6, 11,8,9,10, 15,12,13,14);
+            a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rotl16);
+            c = _mm256_add_epi32(c, d); b = rotlChaCha(_mm256_xor_si256(b, c), 12);
+            a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rotl8);
+            c = _mm256_add_epi32(c, d); b = rotlChaCha(_mm256_xor_si256(b, c), 7);
+        }
+
+        /**
+        @brief Rows of a word for 8 blocks to 8 blocks of 8 words
+        */
+        inline void storeTransposedChaCha(u32* out, const __m256i* rows)
+        {
+            const __m256i t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+            const __m256i t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+            const __m256i t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+            const __m256i t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+            const __m256i t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);
+            const __m256i t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);
+            const __m256i t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);
+            const __m256i t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);
+
+            const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+            const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+            const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+            const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+            const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+            const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+            const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+            const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16*0), _mm256_permute2x128_si256(u0, u4, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16*1), _mm256_permute2x128_si256(u1, u5, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16*2), _mm256_permute2x128_si256(u2, u6, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16*3), _mm256_permute2x128_si256(u3, u7, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16*4), _mm256_permute2x128_si256(u0, u4, 0x31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16*5), _mm256_permute2x128_si256(u1, u5, 0x31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16*6), _mm256_permute2x128_si256(u2, u6, 0x31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16*7), _mm256_permute2x128_si256(u3, u7, 0x31));
+        }
+
+        /**
+        @brief 8 blocks at once, lane k of word i is the word i of the block k
+        */
+        void chacha20(u32* out, const u32 state[16], size_t blocks)
+        {
+            u64 counter = getChaChaCounter(state);
+            const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256i sign = _mm256_set1_epi32(static_cast<s32>(0x80000000U));
+            size_t i = 0;
+            for(; (i+8)<=blocks; i+=8, counter+=8){
+                __m256i input[16];
+                for(u32 j=0; j<16; ++j){
+                    input[j] = _mm256_set1_epi32(static_cast<s32>(state[j]));
+                }
+                //Carry to the upper word where the lower word wrapped, as an unsigned low<lanes
+                const __m256i low = _mm256_add_epi32(_mm256_set1_epi32(static_cast<s32>(counter)), lanes);
+                const __m256i carry = _mm256_cmpgt_epi32(_mm256_xor_si256(lanes, sign), _mm256_xor_si256(low, sign));
+                input[12] = low;
+                input[13] = _mm256_sub_epi32(_mm256_set1_epi32(static_cast<s32>(counter>>32)), carry);
+
+                __m256i x[16];
+                for(u32 j=0; j<16; ++j){
+                    x[j] = input[j];
+                }
+                for(u32 j=0; j<10; ++j){
+                    quarterRoundChaCha(x[0], x[4], x[8], x[12]);
+                    quarterRoundChaCha(x[1], x[5], x[9], x[13]);
+                    quarterRoundChaCha(x[2], x[6], x[10], x[14]);
+                    quarterRoundChaCha(x[3], x[7], x[11], x[15]);
+                    quarterRoundChaCha(x[0], x[5], x[10], x[15]);
+                    quarterRoundChaCha(x[1], x[6], x[11], x[12]);
+                    quarterRoundChaCha(x[2], x[7], x[8], x[13]);
+                    quarterRoundChaCha(x[3], x[4], x[9], x[14]);
+                }
+                for(u32 j=0; j<16; ++j){
+                    x[j] = _mm256_add_epi32(x[j], input[j]);
+                }
+                storeTransposedChaCha(out + 16*i, x);
+                storeTransposedChaCha(out + 16*i + 8, x + 8);
+            }
+            for(; i<blocks; ++i, ++counter){
+                chacha20Block(out + 16*i, state, counter);
+            }
+        }
+    }
+
+    namespace
+    {
+        /**
+        @brief Lower 64 bits of x*y, of three 32 bit multiplies
+        */
+        inline __m256i mullo64(__m256i x, __m256i y)
+        {
+            const __m256i low = _mm256_mul_epu32(x, y);
+            const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), y), _mm256_mul_epu32(x, _mm256_srli_epi64(y, 32)));
+            return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+        }
+
+        void splitMix64(u64* out, u64 state, size_t n)
+        {
+            const __m256i m0 = _mm256_set1_epi64x(static_cast<s64>(0xBF58476D1CE4E5B9ULL));
+            const __m256i m1 = _mm256_set1_epi64x(static_cast<s64>(0x94D049BB133111EBULL));
+            const __m256i step = _mm256_set1_epi64x(static_cast<s64>(4*SplitMix64::Gamma));
+            __m256i z = _mm256_setr_epi64x(
+                static_cast<s64>(state + SplitMix64::Gamma),
+                static_cast<s64>(state + 2*SplitMix64::Gamma),
+                static_cast<s64>(state + 3*SplitMix64::Gamma),
+                static_cast<s64>(state + 4*SplitMix64::Gamma));
+            size_t i = 0;
+            for(; (i+4)<=n; i+=4){
+                __m256i x = mullo64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)), m0);
+                x = mullo64(_mm256_xor_si256(x, _mm256_srli_epi64(x, 27)), m1);
+                x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 31));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out+i), x);
+                z = _mm256_add_epi64(z, step);
+            }
+            state += i*SplitMix64::Gamma;
+            for(; i<n; ++i){
+                state += SplitMix64::Gamma;
+                out[i] = mixSplitMix64(state);
+            }
+        }
+    }
+
+    namespace
+    {
+        /**
+        @brief Upper and lower 32 bits of the products of 8 lanes and m
+        */
+        inline void mulhilo32(__m256i& hi, __m256i& lo, __m256i x, __m256i m)
+        {
+            const __m256i even = _mm256_mul_epu32(x, m);
+            const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), m);
+            hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+            lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        }
+
+        /**
+        @brief 8 blocks at once, lane k of word i is the word i of the block k
+        */
+        void philox4x32(u32* out, u64 key, u64 stream, u64 counter, size_t n)
+        {
+            const __m256i m0 = _mm256_set1_epi32(static_cast<s32>(Philox4x32::M0));
+            const __m256i m1 = _mm256_set1_epi32(static_cast<s32>(Philox4x32::M1));
+            const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256i sign = _mm256_set1_epi32(static_cast<s32>(0x80000000U));
+            const __m256i s0 = _mm256_set1_epi32(static_cast<s32>(stream));
+            const __m256i s1 = _mm256_set1_epi32(static_cast<s32>(stream>>32));
+            size_t i = 0;
+            for(; (i+8)<=n; i+=8, counter+=8){
+                //Carry to the upper word where the lower word wrapped, as an unsigned low<lanes
+                __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(static_cast<s32>(counter)), lanes);
+                const __m256i carry = _mm256_cmpgt_epi32(_mm256_xor_si256(lanes, sign), _mm256_xor_si256(c0, sign));
+                __m256i c1 = _mm256_sub_epi32(_mm256_set1_epi32(static_cast<s32>(counter>>32)), carry);
+                __m256i c2 = s0;
+                __m256i c3 = s1;
+                u32 k0 = static_cast<u32>(key);
+                u32 k1 = static_cast<u32>(key>>32);
+                for(u32 j=0; j<Philox4x32::Rounds; ++j){
+                    __m256i hi0, lo0, hi1, lo1;
+                    mulhilo32(hi0, lo0, c0, m0);
+                    mulhilo32(hi1, lo1, c2, m1);
+                    c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(static_cast<s32>(k0)));
+                    c1 = lo1;
+                    c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(static_cast<s32>(k1)));
+                    c3 = lo0;
+                    k0 += Philox4x32::W0;
+                    k1 += Philox4x32::W1;
+                }
+                const __m256i t0 = _mm256_unpacklo_epi32(c0, c1);
+                const __m256i t1 = _mm256_unpackhi_epi32(c0, c1);
+                const __m256i t2 = _mm256_unpacklo_epi32(c2, c3);
+                const __m256i t3 = _mm256_unpackhi_epi32(c2, c3);
+                const __m256i u0 = _mm256_unpacklo_epi64(t0, t2); //blocks 0 and 4
+                const __m256i u1 = _mm256_unpackhi_epi64(t0, t2); //blocks 1 and 5
+                const __m256i u2 = _mm256_unpacklo_epi64(t1, t3); //blocks 2 and 6
+                const __m256i u3 = _mm256_unpackhi_epi64(t1, t3); //blocks 3 and 7
+                u32* o = out + 4*i;
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(o + 0), _mm256_permute2x128_si256(u0, u1, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(o + 8), _mm256_permute2x128_si256(u2, u3, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(o + 16), _mm256_permute2x128_si256(u0, u1, 0x31));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(o + 24), _mm256_permute2x128_si256(u2, u3, 0x31));
+            }
+            for(; i<n; ++i, ++counter){
+                philox4x32Block(out + 4*i, key, stream, counter);
+            }
+        }
+
+        /**
+        @brief Upper halves of 8 products at once, and the lower halves compared with threshold
+        */
+        u32 mulHighU32(u32* out, const u32* bits, size_t n, u32 range, u32 threshold)
+        {
+            const __m256i r = _mm256_set1_epi32(static_cast<s32>(range));
+            const __m256i sign = _mm256_set1_epi32(static_cast<s32>(0x80000000U));
+            const __m256i t = _mm256_set1_epi32(static_cast<s32>(threshold ^ 0x80000000U));
+            __m256i rejected = _mm256_setzero_si256();
+            size_t i = 0;
+            for(; (i+8)<=n; i+=8){
+                __m256i hi, lo;
+                mulhilo32(hi, lo, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits+i)), r);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out+i), hi);
+                //Unsigned lo<threshold
+                rejected = _mm256_or_si256(rejected, _mm256_cmpgt_epi32(t, _mm256_xor_si256(lo, sign)));
+            }
+            const u32 mask = static_cast<u32>(_mm256_movemask_epi8(rejected));
+            return mask | mulHighU32Loop(out+i, bits+i, n-i, range, threshold);
+        }
+
+        /**
+        @brief 8 indices at once in two vectors, the round multiplies of 64 bits of three 32 bit multiplies
+        */
+        void feistel64(u64* out, const u64* in, size_t n, const u64* keys, u32 rounds, u32 halfBits)
+        {
+            const __m256i m0 = _mm256_set1_epi64x(static_cast<s64>(0xBF58476D1CE4E5B9ULL));
+            const __m256i m1 = _mm256_set1_epi64x(static_cast<s64>(0x94D049BB133111EBULL));
+            const __m256i halfMask = _mm256_set1_epi64x(static_cast<s64>((1ULL<<halfBits) - 1));
+            const __m128i shift = _mm_cvtsi32_si128(static_cast<s32>(halfBits));
+            size_t i = 0;
+            for(; (i+8)<=n; i+=8){
+                const __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in+i));
+                const __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in+i+4));
+                __m256i left0 = _mm256_srl_epi64(x0, shift);
+                __m256i left1 = _mm256_srl_epi64(x1, shift);
+                __m256i right0 = _mm256_and_si256(x0, halfMask);
+                __m256i right1 = _mm256_and_si256(x1, halfMask);
+                for(u32 j=0; j<rounds; ++j){
+                    const __m256i key = _mm256_set1_epi64x(static_cast<s64>(keys[j]));
+                    __m256i z0 = _mm256_xor_si256(right0, key);
+                    __m256i z1 = _mm256_xor_si256(right1, key);
+                    z0 = mullo64(_mm256_xor_si256(z0, _mm256_srli_epi64(z0, 30)), m0);
+                    z1 = mullo64(_mm256_xor_si256(z1, _mm256_srli_epi64(z1, 30)), m0);
+                    z0 = mullo64(_mm256_xor_si256(z0, _mm256_srli_epi64(z0, 27)), m1);
+                    z1 = mullo64(_mm256_xor_si256(z1, _mm256_srli_epi64(z1, 27)), m1);
+                    z0 = _mm256_and_si256(_mm256_xor_si256(z0, _mm256_srli_epi64(z0, 31)), halfMask);
+                    z1 = _mm256_and_si256(_mm256_xor_si256(z1, _mm256_srli_epi64(z1, 31)), halfMask);
+                    const __m256i next0 = _mm256_xor_si256(left0, z0);
+                    const __m256i next1 = _mm256_xor_si256(left1, z1);
+                    left0 = right0;
+                    left1 = right1;
+                    right0 = next0;
+                    right1 = next1;
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out+i), _mm256_or_si256(_mm256_sll_epi64(left0, shift), right0));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out+i+4), _mm256_or_si256(_mm256_sll_epi64(left1, shift), right1));
+            }
+            feistel64Loop(out+i, in+i, n-i, keys, rounds, halfBits);
+        }
+
+        /**
+        @brief Lower 64 bits of x*x, of two 32 bit multiplies
+        */
+        inline __m256i sqrlo64(__m256i x)
+        {
+            const __m256i cross = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), x);
+            return _mm256_add_epi64(_mm256_mul_epu32(x, x), _mm256_slli_epi64(cross, 33));
+        }
+
+        /**
+        @brief Upper 32 bits of 4 lanes of 64 bits
+        */
+        inline __m256i squares4(__m256i counter, __m256i key)
+        {
+            __m256i x = mullo64(counter, key);
+            const __m256i y = x;
+            const __m256i z = _mm256_add_epi64(y, key);
+            //Rotations by 32 are swaps of the halves
+            x = _mm256_shuffle_epi32(_mm256_add_epi64(sqrlo64(x), y), _MM_SHUFFLE(2,3,0,1));
+            x = _mm256_shuffle_epi32(_mm256_add_epi64(sqrlo64(x), z), _MM_SHUFFLE(2,3,0,1));
+            x = _mm256_shuffle_epi32(_mm256_add_epi64(sqrlo64(x), y), _MM_SHUFFLE(2,3,0,1));
+            return _mm256_add_epi64(sqrlo64(x), z);
+        }
+
+        void squares32(u32* out, u64 key, u64 counter, size_t n)
+        {
+            const __m256i k = _mm256_set1_epi64x(static_cast<s64>(key));
+            const __m256i step = _mm256_set1_epi64x(8);
+            const __m256i upper = _mm256_setr_epi32(1, 3, 5, 7, 1, 3, 5, 7);
+            __m256i c0 = _mm256_add_epi64(_mm256_set1_epi64x(static_cast<s64>(counter)), _mm256_setr_epi64x(0, 1, 2, 3));
+            __m256i c1 = _mm256_add_epi64(_mm256_set1_epi64x(static_cast<s64>(counter)), _mm256_setr_epi64x(4, 5, 6, 7));
+            size_t i = 0;
+            for(; (i+8)<=n; i+=8){
+                const __m256i x0 = _mm256_permutevar8x32_epi32(squares4(c0, k), upper);
+                const __m256i x1 = _mm256_permutevar8x32_epi32(squares4(c1, k), upper);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out+i), _mm256_permute2x128_si256(x0, x1, 0x20));
+                c0 = _mm256_add_epi64(c0, step);
+                c1 = _mm256_add_epi64(c1, step);
+            }
+            for(; i<n; ++i){
+                out[i] = squares32Value(counter+i, key);
+            }
+        }
+    }
+
+    bool initRandomKernelsAVX2(RandomKernels& kernels)
+    {
+        initRandomKernels<AVX2Ops>(kernels);
+        kernels.zigguratF32_ = zigguratF32;
+        kernels.zigguratF64_ = zigguratF64;
+
+        kernels.toF32Full_0_ = convertF32<ToF32Full_0>;
+        kernels.toF32Full_1_ = convertF32<ToF32Full_1>;
+        kernels.toF64_0_ = convertF64<ToF64_0>;
+        kernels.toF64_1_ = convertF64<ToF64_1>;
+        kernels.toF64Full_0_ = convertF64<ToF64Full_0>;
+        kernels.toF64Full_1_ = convertF64<ToF64Full_1>;
+        kernels.pairToF64_0_ = convertPairF64<ToF64_0>;
+        kernels.pairToF64_1_ = convertPairF64<ToF64_1>;
+        kernels.pairToF64Full_0_ = convertPairF64<ToF64Full_0>;
+        kernels.pairToF64Full_1_ = convertPairF64<ToF64Full_1>;
+
+        kernels.chacha20_ = chacha20;
+        kernels.splitMix64_ = splitMix64;
+        kernels.philox4x32_ = philox4x32;
+        kernels.squares32_ = squares32;
+        kernels.mulHighU32_ = mulHighU32;
+        kernels.feistel64_ = feistel64;
+        return true;
+    }
+}
+
+#else
+namespace lcore
+{
+    bool initRandomKernelsAVX2(RandomKernels&)
+    {
+        return false;
+    }
+}
+#endif
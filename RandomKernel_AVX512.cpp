@@ -0,0 +1,162 @@
+/**
+@file RandomKernel_AVX512.cpp
+@author t-sakai
+@date 2026/10/17 create
+
+Compiled with AVX-512 F, DQ, BW and VL enabled.
+*/
+#include "RandomKernelImpl.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+//GCC 12 takes _mm512_undefined_epi32() of the unmasked shifts and rotations as uninitialized values, a false -Wmaybe-uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#else
+#include <immintrin.h>
+#endif
+
+namespace lcore
+{
+    namespace
+    {
+        struct AVX512Ops
+        {
+            typedef __m512i type;
+            static const u32 Width = 16;
+
+            static inline type load(const u32* p){ return _mm512_loadu_si512(p);}
+            static inline void store(u32* p, type x){ _mm512_storeu_si512(p, x);}
+            static inline void storeF32_0(f32* p, type x)
+            {
+                x = _mm512_ternarylogic_epi32(x, _mm512_set1_epi32(0x007FFFFF), _mm512_set1_epi32(0x3F800000), 0xEA); //(x&b)|c
+                _mm512_storeu_ps(p, _mm512_sub_ps(_mm512_castsi512_ps(x), _mm512_set1_ps(0.999999881f)));
+            }
+            static inline void storeF32_1(f32* p, type x)
+            {
+                x = _mm512_ternarylogic_epi32(x, _mm512_set1_epi32(0x007FFFFF), _mm512_set1_epi32(0x3F800000), 0xEA); //(x&b)|c
+                _mm512_storeu_ps(p, _mm512_sub_ps(_mm512_castsi512_ps(x), _mm512_set1_ps(1.0f)));
+            }
+            static inline type add(type a, type b){ return _mm512_add_epi32(a, b);}
+            static inline type bxor(type a, type b){ return _mm512_xor_si512(a, b);}
+            static inline type shl(type x, s32 k){ return _mm512_slli_epi32(x, k);}
+            static inline type rotl(type x, s32 k){ return _mm512_rolv_epi32(x, _mm512_set1_epi32(k));}
+        };
+    }
+
+    namespace
+    {
+        void splitMix64(u64* out, u64 state, size_t n)
+        {
+            const __m512i m0 = _mm512_set1_epi64(static_cast<s64>(0xBF58476D1CE4E5B9ULL));
+            const __m512i m1 = _mm512_set1_epi64(static_cast<s64>(0x94D049BB133111EBULL));
+            const __m512i step = _mm512_set1_epi64(static_cast<s64>(8*SplitMix64::Gamma));
+            __m512i z = _mm512_setr_epi64(
+                static_cast<s64>(state + SplitMix64::Gamma),
+                static_cast<s64>(state + 2*SplitMix64::Gamma),
+                static_cast<s64>(state + 3*SplitMix64::Gamma),
+                static_cast<s64>(state + 4*SplitMix64::Gamma),
+                static_cast<s64>(state + 5*SplitMix64::Gamma),
+                static_cast<s64>(state + 6*SplitMix64::Gamma),
+                static_cast<s64>(state + 7*SplitMix64::Gamma),
+                static_cast<s64>(state + 8*SplitMix64::Gamma));
+            size_t i = 0;
+            for(; (i+8)<=n; i+=8){
+                __m512i x = _mm512_mullo_epi64(_mm512_xor_si512(z, _mm512_srli_epi64(z, 30)), m0);
+                x = _mm512_mullo_epi64(_mm512_xor_si512(x, _mm512_srli_epi64(x, 27)), m1);
+                x = _mm512_xor_si512(x, _mm512_srli_epi64(x, 31));
+                _mm512_storeu_si512(out+i, x);
+                z = _mm512_add_epi64(z, step);
+            }
+            state += i*SplitMix64::Gamma;
+            for(; i<n; ++i){
+                state += SplitMix64::Gamma;
+                out[i] = mixSplitMix64(state);
+            }
+        }
+    }
+
+    namespace
+    {
+        /**
+        @brief Upper halves of 16 products at once, and the lower halves compared with threshold
+        */
+        u32 mulHighU32(u32* out, const u32* bits, size_t n, u32 range, u32 threshold)
+        {
+            const __m512i r = _mm512_set1_epi32(static_cast<s32>(range));
+            const __m512i t = _mm512_set1_epi32(static_cast<s32>(threshold));
+            __mmask16 rejected = 0;
+            size_t i = 0;
+            for(; (i+16)<=n; i+=16){
+                const __m512i x = _mm512_loadu_si512(bits+i);
+                const __m512i even = _mm512_mul_epu32(x, r);
+                const __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(x, 32), r);
+                _mm512_storeu_si512(out+i, _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd));
+                const __m512i lo = _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+                rejected |= _mm512_cmplt_epu32_mask(lo, t);
+            }
+            return static_cast<u32>(rejected) | mulHighU32Loop(out+i, bits+i, n-i, range, threshold);
+        }
+
+        /**
+        @brief 16 indices at once in two vectors
+        */
+        void feistel64(u64* out, const u64* in, size_t n, const u64* keys, u32 rounds, u32 halfBits)
+        {
+            const __m512i m0 = _mm512_set1_epi64(static_cast<s64>(0xBF58476D1CE4E5B9ULL));
+            const __m512i m1 = _mm512_set1_epi64(static_cast<s64>(0x94D049BB133111EBULL));
+            const __m512i halfMask = _mm512_set1_epi64(static_cast<s64>((1ULL<<halfBits) - 1));
+            const __m128i shift = _mm_cvtsi32_si128(static_cast<s32>(halfBits));
+            size_t i = 0;
+            for(; (i+16)<=n; i+=16){
+                const __m512i x0 = _mm512_loadu_si512(in+i);
+                const __m512i x1 = _mm512_loadu_si512(in+i+8);
+                __m512i left0 = _mm512_srl_epi64(x0, shift);
+                __m512i left1 = _mm512_srl_epi64(x1, shift);
+                __m512i right0 = _mm512_and_si512(x0, halfMask);
+                __m512i right1 = _mm512_and_si512(x1, halfMask);
+                for(u32 j=0; j<rounds; ++j){
+                    const __m512i key = _mm512_set1_epi64(static_cast<s64>(keys[j]));
+                    __m512i z0 = _mm512_xor_si512(right0, key);
+                    __m512i z1 = _mm512_xor_si512(right1, key);
+                    z0 = _mm512_mullo_epi64(_mm512_xor_si512(z0, _mm512_srli_epi64(z0, 30)), m0);
+                    z1 = _mm512_mullo_epi64(_mm512_xor_si512(z1, _mm512_srli_epi64(z1, 30)), m0);
+                    z0 = _mm512_mullo_epi64(_mm512_xor_si512(z0, _mm512_srli_epi64(z0, 27)), m1);
+                    z1 = _mm512_mullo_epi64(_mm512_xor_si512(z1, _mm512_srli_epi64(z1, 27)), m1);
+                    z0 = _mm512_xor_si512(z0, _mm512_srli_epi64(z0, 31));
+                    z1 = _mm512_xor_si512(z1, _mm512_srli_epi64(z1, 31));
+                    const __m512i next0 = _mm512_ternarylogic_epi64(left0, z0, halfMask, 0x78); //a^(b&c)
+                    const __m512i next1 = _mm512_ternarylogic_epi64(left1, z1, halfMask, 0x78); //a^(b&c)
+                    left0 = right0;
+                    left1 = right1;
+                    right0 = next0;
+                    right1 = next1;
+                }
+                _mm512_storeu_si512(out+i, _mm512_or_si512(_mm512_sll_epi64(left0, shift), right0));
+                _mm512_storeu_si512(out+i+8, _mm512_or_si512(_mm512_sll_epi64(left1, shift), right1));
+            }
+            feistel64Loop(out+i, in+i, n-i, keys, rounds, halfBits);
+        }
+    }
+
+    bool initRandomKernelsAVX512(RandomKernels& kernels)
+    {
+        initRandomKernels<AVX512Ops>(kernels);
+        kernels.splitMix64_ = splitMix64;
+        kernels.mulHighU32_ = mulHighU32;
+        kernels.feistel64_ = feistel64;
+        return true;
+    }
+}
+
+#else
+namespace lcore
+{
+    bool initRandomKernelsAVX512(RandomKernels&)
+    {
+        return false;
+    }
+}
+#endif
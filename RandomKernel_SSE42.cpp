@@ -0,0 +1,56 @@
+/**
+@file RandomKernel_SSE42.cpp
+@author t-sakai
+@date 2026/10/17 create
+
+Compiled with SSE4.2 enabled.
+*/
+#include "RandomKernelImpl.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <nmmintrin.h>
+
+namespace lcore
+{
+    namespace
+    {
+        struct SSE42Ops
+        {
+            typedef __m128i type;
+            static const u32 Width = 4;
+
+            static inline type load(const u32* p){ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));}
+            static inline void store(u32* p, type x){ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x);}
+            static inline void storeF32_0(f32* p, type x)
+            {
+                x = _mm_or_si128(_mm_and_si128(x, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000));
+                _mm_storeu_ps(p, _mm_sub_ps(_mm_castsi128_ps(x), _mm_set1_ps(0.999999881f)));
+            }
+            static inline void storeF32_1(f32* p, type x)
+            {
+                x = _mm_or_si128(_mm_and_si128(x, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000));
+                _mm_storeu_ps(p, _mm_sub_ps(_mm_castsi128_ps(x), _mm_set1_ps(1.0f)));
+            }
+            static inline type add(type a, type b){ return _mm_add_epi32(a, b);}
+            static inline type bxor(type a, type b){ return _mm_xor_si128(a, b);}
+            static inline type shl(type x, s32 k){ return _mm_slli_epi32(x, k);}
+            static inline type rotl(type x, s32 k){ return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32-k));}
+        };
+    }
+
+    bool initRandomKernelsSSE42(RandomKernels& kernels)
+    {
+        initRandomKernels<SSE42Ops>(kernels);
+        return true;
+    }
+}
+
+#else
+namespace lcore
+{
+    bool initRandomKernelsSSE42(RandomKernels&)
+    {
+        return false;
+    }
+}
+#endif
@@ -0,0 +1,65 @@
+/**
+@file RandomPermutation.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "RandomPermutation.h"
+#include "RandomKernel.h"
+
+namespace lcore
+{
+    RandomPermutation::RandomPermutation()
+        :size_(0)
+        ,halfBits_(1)
+        ,halfMask_(1)
+    {
+        for(u32 i=0; i<Rounds; ++i){
+            keys_[i] = 0;
+        }
+    }
+
+    void RandomPermutation::initialize(const u64 keys[Rounds], u64 size)
+    {
+        LASSERT(NULL != keys);
+        size_ = size;
+        //Bits of size-1, rounded up to even, at least 2
+        u32 bits = 0;
+        for(u64 x = (0<size)? size-1 : 0; 0 != x; x>>=1){
+            ++bits;
+        }
+        halfBits_ = (bits<=2)? 1 : (bits+1)>>1;
+        halfMask_ = (1ULL<<halfBits_) - 1;
+        for(u32 i=0; i<Rounds; ++i){
+            keys_[i] = keys[i];
+        }
+    }
+
+    void RandomPermutation::map(u64* values, const u64* indices, size_t n) const
+    {
+        LASSERT((NULL != values && NULL != indices) || 0 == n);
+        for(size_t i=0; i<n; ++i){
+            LASSERT(indices[i]<size_);
+        }
+        getRandomKernels().feistel64_(values, indices, n, keys_, Rounds, halfBits_);
+        for(size_t i=0; i<n; ++i){
+            while(size_<=values[i]){
+                values[i] = encrypt(values[i]);
+            }
+        }
+    }
+
+    void RandomPermutation::fill(u64* values, u64 start, size_t n) const
+    {
+        LASSERT(NULL != values || 0 == n);
+        LASSERT(n<=size_ && start<=(size_-n));
+        for(size_t i=0; i<n; ++i){
+            values[i] = start+i;
+        }
+        getRandomKernels().feistel64_(values, values, n, keys_, Rounds, halfBits_);
+        for(size_t i=0; i<n; ++i){
+            while(size_<=values[i]){
+                values[i] = encrypt(values[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef INC_RANDOMPERMUTATION_H_
+#define INC_RANDOMPERMUTATION_H_
+/**
+@file RandomPermutation.h
+@author t-sakai
+@date 2026/10/17 create
+
+A random permutation of [0, size) computed for each index, without an array.
+
+A keyed Feistel network permutes the smallest domain of an even number of bits which covers size,
+and cycle-walking encrypts the outputs outside [0, size) again until they fall inside.
+The domain is less than 4*size, so fewer than 4 passes of the network are expected for an index.
+Feistel networks of a few bits can not reach every permutation evenly, so the permutation is meant for large sizes,
+for small ones it is only approximately uniform.
+*/
+#include "Random.h"
+
+namespace lcore
+{
+    class RandomPermutation
+    {
+    public:
+        static const u32 Rounds = 6;
+
+        RandomPermutation();
+
+        /**
+        @brief Permutation of [0, size) keyed by random
+        */
+        template<class T>
+        RandomPermutation(T& random, u64 size)
+        {
+            u64 keys[Rounds];
+            for(u32 i=0; i<Rounds; ++i){
+                keys[i] = RandomBits<T>::rand64(random);
+            }
+            initialize(keys, size);
+        }
+
+        /**
+        @brief Initialize with keys of each round
+        */
+        void initialize(const u64 keys[Rounds], u64 size);
+
+        inline u64 size() const;
+
+        /**
+        @brief The index-th value of the permutation, index should be in [0, size)
+        */
+        inline u64 operator[](u64 index) const;
+
+        /**
+        @brief values[i] = (*this)[indices[i]]
+
+        The network first runs once over all indices in the SIMD kernels, then only values outside [0, size) walk again one by one.
+        */
+        void map(u64* values, const u64* indices, size_t n) const;
+
+        /**
+        @brief values[i] = (*this)[start+i]
+        */
+        void fill(u64* values, u64 start, size_t n) const;
+
+    private:
+        inline u64 encrypt(u64 x) const;
+
+        u64 size_;
+        u32 halfBits_;
+        u64 halfMask_;
+        u64 keys_[Rounds];
+    };
+
+    inline u64 RandomPermutation::size() const
+    {
+        return size_;
+    }
+
+    inline u64 RandomPermutation::encrypt(u64 x) const
+    {
+        u64 left = x>>halfBits_;
+        u64 right = x&halfMask_;
+        for(u32 i=0; i<Rounds; ++i){
+            //splitmix64 finalizer as the round function
+            u64 z = right ^ keys_[i];
+            z = (z ^ (z>>30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z>>27)) * 0x94D049BB133111EBULL;
+            z ^= (z>>31);
+            const u64 next = left ^ (z&halfMask_);
+            left = right;
+            right = next;
+        }
+        return (left<<halfBits_) | right;
+    }
+
+    inline u64 RandomPermutation::operator[](u64 index) const
+    {
+        LASSERT(index<size_);
+        u64 x = encrypt(index);
+        while(size_<=x){
+            x = encrypt(x);
+        }
+        return x;
+    }
+}
+#endif //INC_RANDOMPERMUTATION_H_
@@ -0,0 +1,78 @@
+/**
+@file RandomPrefetch.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "RandomPrefetch.h"
+#include <chrono>
+#include <cstdlib>
+
+namespace lcore
+{
+    //---------------------------------------------
+    //---
+    //--- PrefetchRing
+    //---
+    //---------------------------------------------
+    PrefetchRing::PrefetchRing(size_t blockBytes, u32 blocks, Produce produce, void* context)
+        :blockBytes_(blockBytes)
+        ,blocks_(blocks)
+        ,produce_(produce)
+        ,context_(context)
+        ,allocated_(NULL)
+        ,memory_(NULL)
+        ,consumerHead_(0)
+        ,consumerTail_(0)
+    {
+        LASSERT(0<blockBytes && 0 == (blockBytes&(CacheLineSize-1)));
+        LASSERT(0<blocks && 0 == (blocks&(blocks-1)));
+        LASSERT(NULL != produce);
+
+        allocated_ = malloc(blockBytes_*blocks_ + CacheLineSize);
+        LASSERT(NULL != allocated_);
+        const uintptr_t address = reinterpret_cast<uintptr_t>(allocated_);
+        memory_ = reinterpret_cast<u8*>((address + CacheLineSize-1) & ~static_cast<uintptr_t>(CacheLineSize-1));
+
+        head_.value_.store(0, std::memory_order_relaxed);
+        tail_.value_.store(0, std::memory_order_relaxed);
+        stop_.value_.store(0, std::memory_order_relaxed);
+        thread_ = std::thread(&PrefetchRing::run, this);
+    }
+
+    PrefetchRing::~PrefetchRing()
+    {
+        stop_.value_.store(1, std::memory_order_release);
+        if(thread_.joinable()){
+            thread_.join();
+        }
+        free(allocated_);
+    }
+
+    void PrefetchRing::run()
+    {
+        //Spin on yield for a while after the last block, then sleep, so that an idle ring does not take a core
+        static const u32 SpinCount = 1024;
+        u64 head = 0;
+        u64 tail = 0;
+        u32 idle = 0;
+        while(0 == stop_.value_.load(std::memory_order_acquire)){
+            if((head-tail)<blocks_){
+                produce_(context_, memory_ + (head&(blocks_-1))*blockBytes_, blockBytes_);
+                ++head;
+                head_.value_.store(head, std::memory_order_release);
+                idle = 0;
+                continue;
+            }
+            tail = tail_.value_.load(std::memory_order_acquire);
+            if((head-tail)<blocks_){
+                continue;
+            }
+            if(idle<SpinCount){
+                ++idle;
+                std::this_thread::yield();
+            }else{
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+    }
+}
@@ -0,0 +1,307 @@
+#ifndef INC_RANDOMPREFETCH_H_
+#define INC_RANDOMPREFETCH_H_
+/**
+@file RandomPrefetch.h
+@author t-sakai
+@date 2026/10/17 create
+
+Random numbers generated ahead of the use on a thread of their own.
+
+A producer thread fills the blocks of a single-producer/single-consumer ring by the bulk fill of the generator,
+and the consumer takes values from the current block by a pointer bump.
+The consumer and the producer only exchange two indices on separate cache lines, without locks.
+When the ring runs dry, the consumer waits for the producer, or generates a short block inline from a second stream.
+
+    PrefetchedRandom<Xoshiro128Plus> random(Xoshiro128Plus(seed));
+    u32 x = random.rand();
+*/
+#include "Random.h"
+#include <atomic>
+#include <thread>
+
+namespace lcore
+{
+    /**
+    @brief What the consumer does when the ring is empty
+    */
+    enum PrefetchFallback
+    {
+        PrefetchFallback_Wait = 0, //!< Wait for the producer, the values are the producer's sequence
+        PrefetchFallback_Inline, //!< Generate inline from the fallback generator, which never waits
+    };
+
+    //---------------------------------------------
+    //---
+    //--- PrefetchRing
+    //---
+    //---------------------------------------------
+    /**
+    @brief The ring of blocks and the producer thread, without the type of the generator
+    */
+    class PrefetchRing
+    {
+    public:
+        /**
+        @brief Fill a block of bytes, called on the producer thread
+        */
+        typedef void (*Produce)(void* context, void* block, size_t bytes);
+
+        static const u32 CacheLineSize = 64;
+
+        /**
+        @param blockBytes ... multiple of CacheLineSize
+        @param blocks ... power of 2
+        */
+        PrefetchRing(size_t blockBytes, u32 blocks, Produce produce, void* context);
+
+        /**
+        @brief Stop and join the producer
+        */
+        ~PrefetchRing();
+
+        /**
+        @brief The oldest filled block for the consumer, NULL if the ring is empty
+        */
+        inline const void* acquire()
+        {
+            if(consumerHead_ == consumerTail_){
+                consumerHead_ = head_.value_.load(std::memory_order_acquire);
+                if(consumerHead_ == consumerTail_){
+                    return NULL;
+                }
+            }
+            return memory_ + (consumerTail_&(blocks_-1))*blockBytes_;
+        }
+
+        /**
+        @brief Give the block of the last acquire back to the producer
+        */
+        inline void release()
+        {
+            ++consumerTail_;
+            tail_.value_.store(consumerTail_, std::memory_order_release);
+        }
+
+        size_t getBlockBytes() const{ return blockBytes_;}
+
+    private:
+        PrefetchRing(const PrefetchRing&) = delete;
+        PrefetchRing& operator=(const PrefetchRing&) = delete;
+
+        /**
+        @brief An index on a cache line of its own, padded on both sides without over-aligned allocation
+        */
+        struct Index
+        {
+            u8 before_[CacheLineSize];
+            std::atomic<u64> value_;
+            u8 after_[CacheLineSize-sizeof(std::atomic<u64>)];
+        };
+
+        void run();
+
+        size_t blockBytes_;
+        u32 blocks_;
+        Produce produce_;
+        void* context_;
+        void* allocated_;
+        u8* memory_; //!< Aligned to CacheLineSize
+
+        Index head_; //!< Blocks filled, written by the producer
+        Index tail_; //!< Blocks released, written by the consumer
+        Index stop_;
+        u64 consumerHead_; //!< Last head seen by the consumer
+        u64 consumerTail_;
+
+        std::thread thread_;
+    };
+
+    //---------------------------------------------
+    //---
+    //--- PrefetchedRandom
+    //---
+    //---------------------------------------------
+    /**
+    @brief A generator of the values of T made on a producer thread
+
+    rand() gives the result type of T, so RandomBits, boundedRandom and the distributions take this as T.
+    */
+    template<class T, u32 BlockSize=1024, u32 Blocks=16>
+    class PrefetchedRandom
+    {
+    public:
+        typedef typename RandomBits<T>::result_type result_type;
+
+        static const u32 InlineSize = 64; //!< Values of an inline block, short to bound the latency
+
+        /**
+        @brief The producer continues random, and the fallback is random after a longJump
+
+        The lanes of the bulk fill of the producer are jump() apart, so the fallback skips them all by longJump().
+        */
+        explicit PrefetchedRandom(const T& random, PrefetchFallback fallback=PrefetchFallback_Inline)
+            :fallback_(fallback)
+            ,producer_(random)
+            ,inline_(longJumped(random, 0))
+            ,current_(NULL)
+            ,end_(NULL)
+            ,holding_(false)
+            ,dry_(0)
+            ,ring_(BlockSize*sizeof(result_type), Blocks, produce, &producer_)
+        {}
+
+        /**
+        @param inlineRandom ... a stream disjoint from random and all lanes of its fill, for generators without longJump
+        */
+        PrefetchedRandom(const T& random, const T& inlineRandom, PrefetchFallback fallback=PrefetchFallback_Inline)
+            :fallback_(fallback)
+            ,producer_(random)
+            ,inline_(inlineRandom)
+            ,current_(NULL)
+            ,end_(NULL)
+            ,holding_(false)
+            ,dry_(0)
+            ,ring_(BlockSize*sizeof(result_type), Blocks, produce, &producer_)
+        {}
+
+        ~PrefetchedRandom()
+        {}
+
+        result_type rand()
+        {
+            if(end_<=current_){
+                next();
+            }
+            return *current_++;
+        }
+
+        /**
+        @brief Generate a float in (0, 1]
+        */
+        f32 frand()
+        {
+            return toF32(RandomBits<PrefetchedRandom>::rand32(*this)) - 0.999999881f;
+        }
+
+        /**
+        @brief Generate a float in [0, 1)
+        */
+        f32 frand2()
+        {
+            return toF32(RandomBits<PrefetchedRandom>::rand32(*this)) - 1.0f;
+        }
+
+        /**
+        @brief Generate a double in [0, 1) of 53 bits, from two values of 32 bit generators
+        */
+        f64 drand2()
+        {
+            return static_cast<f64>(RandomBits<PrefetchedRandom>::rand64(*this)>>11) * (1.0/9007199254740992.0);
+        }
+
+        /**
+        @brief Same as n calls of rand(), by copies of whole blocks
+        */
+        void fill(result_type* out, size_t n)
+        {
+            LASSERT(NULL != out || 0 == n);
+            while(0<n){
+                if(end_<=current_){
+                    next();
+                }
+                size_t count = static_cast<size_t>(end_-current_);
+                count = (n<count)? n : count;
+                memcpy(out, current_, count*sizeof(result_type));
+                current_ += count;
+                out += count;
+                n -= count;
+            }
+        }
+
+        /**
+        @brief Times the ring was empty when the consumer needed a block
+        */
+        u64 getDryCount() const{ return dry_;}
+
+    private:
+        PrefetchedRandom(const PrefetchedRandom&) = delete;
+        PrefetchedRandom& operator=(const PrefetchedRandom&) = delete;
+
+        static inline f32 toF32(u32 x)
+        {
+            x = 0x3F800000U | (x&0x007FFFFFU);
+            f32 f;
+            memcpy(&f, &x, sizeof(f32));
+            return f;
+        }
+
+        template<class U>
+        static auto longJumped(const U& random, int) -> decltype(std::declval<U&>().longJump(), U())
+        {
+            U result(random);
+            result.longJump();
+            return result;
+        }
+
+        template<class U>
+        static U longJumped(const U& random, long)
+        {
+            static_assert(sizeof(U) == 0, "T has no longJump, give the inline generator to the constructor");
+            return random;
+        }
+
+        static void fillWords(T& random, u32* out, size_t n)
+        {
+            RandomBits<T>::fill32(random, out, n);
+        }
+
+        static void fillWords(T& random, u64* out, size_t n)
+        {
+            RandomBits<T>::fill64(random, out, n);
+        }
+
+        static void produce(void* context, void* block, size_t bytes)
+        {
+            fillWords(*static_cast<T*>(context), static_cast<result_type*>(block), bytes/sizeof(result_type));
+        }
+
+        void next()
+        {
+            if(holding_){
+                //The block in use is done
+                ring_.release();
+                holding_ = false;
+            }
+            const result_type* block = static_cast<const result_type*>(ring_.acquire());
+            if(NULL == block){
+                ++dry_;
+                if(PrefetchFallback_Inline == fallback_){
+                    fillWords(inline_, inlineBlock_, InlineSize);
+                    current_ = inlineBlock_;
+                    end_ = inlineBlock_ + InlineSize;
+                    return;
+                }
+                do{
+                    std::this_thread::yield();
+                    block = static_cast<const result_type*>(ring_.acquire());
+                }while(NULL == block);
+            }
+            holding_ = true;
+            current_ = block;
+            end_ = block + BlockSize;
+        }
+
+        PrefetchFallback fallback_;
+        u8 before_[PrefetchRing::CacheLineSize];
+        T producer_; //!< Used only by the producer thread, on lines of its own
+        u8 after_[PrefetchRing::CacheLineSize];
+        T inline_;
+        const result_type* current_;
+        const result_type* end_;
+        bool holding_; //!< Whether current_ is in a block of the ring
+        u64 dry_;
+        result_type inlineBlock_[InlineSize];
+        PrefetchRing ring_; //!< The last member, so the producer stops before the others are destroyed
+    };
+}
+#endif //INC_RANDOMPREFETCH_H_
@@ -0,0 +1,184 @@
+/**
+@file RandomRegistry.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "RandomRegistry.h"
+#include "RandomCounter.h"
+#include <cstring>
+#include <new>
+
+namespace lcore
+{
+    namespace
+    {
+        /**
+        @brief The parameter of the constructor, the result type for the generators seeded by srand
+        */
+        template<class T>
+        struct SeedType
+        {
+            typedef decltype(std::declval<T&>().rand()) type;
+        };
+
+        /**
+        @brief The key of the counter-based generators is 64 bits
+        */
+        template<class T>
+        struct SeedType<CounterRandom<T> >
+        {
+            typedef u64 type;
+        };
+
+        template<class T>
+        struct Registered
+        {
+            typedef decltype(std::declval<T&>().rand()) result_type;
+
+            static void construct(void* storage, u64 seed)
+            {
+                new(storage) T(static_cast<typename SeedType<T>::type>(seed));
+            }
+
+            static void destruct(void* storage)
+            {
+                static_cast<T*>(storage)->~T();
+            }
+
+            template<class U>
+            static auto fillRaw(U& random, u32* out, size_t n, int) -> decltype(random.fill(out, n), void())
+            {
+                random.fill(out, n);
+            }
+
+            /**
+            @brief rand() for generators without fill
+            */
+            template<class U>
+            static void fillRaw(U& random, u32* out, size_t n, long)
+            {
+                static const size_t Words = sizeof(result_type)/sizeof(u32);
+                size_t i = 0;
+                for(; (i+Words)<=n; i+=Words){
+                    const result_type x = random.rand();
+                    memcpy(out+i, &x, sizeof(result_type));
+                }
+                if(i<n){
+                    const result_type x = random.rand();
+                    memcpy(out+i, &x, (n-i)*sizeof(u32));
+                }
+            }
+
+            static void fill(void* random, u32* out, size_t n)
+            {
+                LASSERT(NULL != out || 0 == n);
+                fillRaw(*static_cast<T*>(random), out, n, 0);
+            }
+
+            template<class U>
+            static auto dfillRaw(U& random, f64* out, size_t n, int) -> decltype(random.dfill2(out, n), void())
+            {
+                random.dfill2(out, n);
+            }
+
+            template<class U>
+            static void dfillRaw(U& random, f64* out, size_t n, long)
+            {
+                for(size_t i=0; i<n; ++i){
+                    out[i] = random.drand2();
+                }
+            }
+
+            static void dfill(void* random, f64* out, size_t n)
+            {
+                LASSERT(NULL != out || 0 == n);
+                dfillRaw(*static_cast<T*>(random), out, n, 0);
+            }
+
+            template<class U>
+            static constexpr auto hasJump(int) -> decltype(std::declval<U&>().jump(), bool())
+            {
+                return true;
+            }
+
+            template<class U>
+            static constexpr bool hasJump(long)
+            {
+                return false;
+            }
+
+            static RandomGeneratorInfo create(const Char* name)
+            {
+                static_assert(sizeof(T)<=AnyRandom::StorageSize, "AnyRandom::StorageSize is too small");
+                static_assert(alignof(T)<=16, "AnyRandom::storage_ is not aligned enough");
+                RandomGeneratorInfo info = {
+                    name,
+                    static_cast<u32>(sizeof(result_type)*8),
+                    hasJump<T>(0),
+                    sizeof(T),
+                    alignof(T),
+                    construct,
+                    destruct,
+                    fill,
+                    dfill,
+                };
+                return info;
+            }
+        };
+
+        static const RandomGeneratorInfo Generators[] =
+        {
+            Registered<Xoshiro128Plus>::create("Xoshiro128Plus"),
+            Registered<Xoshiro128Star>::create("Xoshiro128Star"),
+            Registered<Xoshiro128PlusPlus>::create("Xoshiro128PlusPlus"),
+            Registered<Xoroshiro128Plus>::create("Xoroshiro128Plus"),
+            Registered<Xoroshiro256Plus>::create("Xoroshiro256Plus"),
+            Registered<Xoshiro256StarStar>::create("Xoshiro256StarStar"),
+            Registered<Xoroshiro512Plus>::create("Xoroshiro512Plus"),
+            Registered<PCG64DXSM>::create("PCG64DXSM"),
+            Registered<SFC64>::create("SFC64"),
+            Registered<RomuTrio>::create("RomuTrio"),
+            Registered<RandWELL>::create("WELL512"),
+            Registered<PhiloxRandom>::create("Philox4x32"),
+            Registered<SquaresRandom>::create("Squares32"),
+        };
+    }
+
+    u32 getNumRandomGenerators()
+    {
+        return static_cast<u32>(sizeof(Generators)/sizeof(Generators[0]));
+    }
+
+    const RandomGeneratorInfo& getRandomGeneratorInfo(u32 index)
+    {
+        LASSERT(index<getNumRandomGenerators());
+        return Generators[index];
+    }
+
+    const RandomGeneratorInfo* findRandomGenerator(const Char* name)
+    {
+        LASSERT(NULL != name);
+        for(u32 i=0; i<getNumRandomGenerators(); ++i){
+            if(0 == strcmp(Generators[i].name_, name)){
+                return &Generators[i];
+            }
+        }
+        return NULL;
+    }
+
+    //---------------------------------------------
+    //---
+    //--- AnyRandom
+    //---
+    //---------------------------------------------
+    AnyRandom::AnyRandom(const RandomGeneratorInfo& info, u64 seed)
+        :info_(&info)
+    {
+        info_->construct_(storage_, seed);
+    }
+
+    AnyRandom::~AnyRandom()
+    {
+        info_->destruct_(storage_);
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef INC_RANDOMREGISTRY_H_
+#define INC_RANDOMREGISTRY_H_
+/**
+@file RandomRegistry.h
+@author t-sakai
+@date 2026/10/17 create
+
+The generators by name, for tools and benchmarks which choose one at runtime.
+
+Each entry has the functions of one instantiation, and AnyRandom calls them once for each buffer,
+so callers are not templates and the cost of the dispatch is shared by the values of a buffer.
+
+    const RandomGeneratorInfo* info = findRandomGenerator("SFC64");
+    AnyRandom random(*info, seed);
+    random.fill(buffer, n);
+*/
+#include "Random.h"
+
+namespace lcore
+{
+    struct RandomGeneratorInfo
+    {
+        const Char* name_;
+        u32 bits_; //!< of rand()
+        bool jump_; //!< has jump for StreamFactory
+        size_t size_;
+        size_t align_;
+
+        void (*construct_)(void* storage, u64 seed);
+        void (*destruct_)(void* storage);
+
+        /**
+        @brief Raw output of n words, 64 bit outputs are two words in the memory order
+        */
+        void (*fill_)(void* random, u32* out, size_t n);
+
+        /**
+        @brief Doubles in [0, 1), by dfill2 or drand2
+        */
+        void (*dfill_)(void* random, f64* out, size_t n);
+    };
+
+    u32 getNumRandomGenerators();
+    const RandomGeneratorInfo& getRandomGeneratorInfo(u32 index);
+
+    /**
+    @return NULL if no generator has the name
+    */
+    const RandomGeneratorInfo* findRandomGenerator(const Char* name);
+
+    //---------------------------------------------
+    //---
+    //--- AnyRandom
+    //---
+    //---------------------------------------------
+    /**
+    @brief A generator of the registry, without a template
+    */
+    class AnyRandom
+    {
+    public:
+        static const u32 StorageSize = 192;
+
+        /**
+        @brief Constructed as T(seed), with the seed cast to the word type of rand(), or the whole 64 bit key of the counter-based generators
+        */
+        AnyRandom(const RandomGeneratorInfo& info, u64 seed);
+        ~AnyRandom();
+
+        const RandomGeneratorInfo& info() const{ return *info_;}
+
+        void fill(u32* out, size_t n)
+        {
+            info_->fill_(storage_, out, n);
+        }
+
+        void dfill(f64* out, size_t n)
+        {
+            info_->dfill_(storage_, out, n);
+        }
+
+    private:
+        AnyRandom(const AnyRandom&) = delete;
+        AnyRandom& operator=(const AnyRandom&) = delete;
+
+        const RandomGeneratorInfo* info_;
+        alignas(16) u8 storage_[StorageSize];
+    };
+}
+#endif //INC_RANDOMREGISTRY_H_
@@ -0,0 +1,225 @@
+#ifndef INC_RANDOMSAMPLING_H_
+#define INC_RANDOMSAMPLING_H_
+/**
+@file RandomSampling.h
+@author t-sakai
+@date 2026/10/17 create
+
+Samples of k items from streams and ranges.
+
+ReservoirSampler is Li's Algorithm L. It draws the gap to the next replacement from a geometric distribution,
+so a stream of n items takes O(k(1 + log(n/k))) draws instead of one for each item.
+WeightedReservoirSampler is Efraimidis and Spirakis's A-ExpJ, which jumps over a drawn amount of weight in the same way.
+sampleWithoutReplacement is Floyd's algorithm, k draws for k distinct values of [0, n).
+*/
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "RandomDistribution.h"
+
+namespace lcore
+{
+    //----------------------------------------------------
+    //---
+    //--- ReservoirSampler
+    //---
+    //----------------------------------------------------
+    /**
+    @brief Uniform sample of k items from a stream of unknown length
+
+        ReservoirSampler<Item> sampler(k);
+        while(read(item)){
+            sampler.push(random, item);
+        }
+
+    Callers which can skip items without reading them may jump to nextIndex() instead, and call push for that item.
+    */
+    template<class U>
+    class ReservoirSampler
+    {
+    public:
+        explicit ReservoirSampler(u32 k)
+            :k_(k)
+            ,count_(0)
+            ,next_(k)
+            ,logW_(0.0)
+        {
+            LASSERT(0<k);
+            samples_.reserve(k);
+        }
+
+        /**
+        @brief Number of items pushed or skipped
+        */
+        u64 count() const{ return count_;}
+
+        /**
+        @brief Index in the stream of the next item which enters the sample
+        */
+        u64 nextIndex() const{ return (count_<k_)? count_ : next_;}
+
+        const std::vector<U>& samples() const{ return samples_;}
+
+        /**
+        @brief Offer the item at index count()
+        */
+        template<class T>
+        void push(T& random, const U& value)
+        {
+            if(count_<k_){
+                samples_.push_back(value);
+                ++count_;
+                if(count_ == k_){
+                    logW_ = std::log(detail::uniformLeftOpen(random))/k_;
+                    next_ = count_ + skip(random);
+                }
+                return;
+            }
+            if(count_ == next_){
+                samples_[boundedRandom32(random, k_)] = value;
+                logW_ += std::log(detail::uniformLeftOpen(random))/k_;
+                next_ = count_ + 1 + skip(random);
+            }
+            ++count_;
+        }
+
+        /**
+        @brief Offer the item at index, passing the items from count() to index, which should not be beyond nextIndex()
+        */
+        template<class T>
+        void pushAt(T& random, u64 index, const U& value)
+        {
+            LASSERT(count_<=index && index<=nextIndex());
+            count_ = index;
+            push(random, value);
+        }
+
+    private:
+        /**
+        @brief Items to pass before the next replacement, geometric of 1-W
+        */
+        template<class T>
+        u64 skip(T& random) const
+        {
+            const f64 logQ = std::log1p(-std::exp(logW_));
+            const f64 s = std::floor(std::log(detail::uniformLeftOpen(random))/logQ);
+            return (s<9.0e18)? static_cast<u64>(s) : 9000000000000000000ULL;
+        }
+
+        u32 k_;
+        u64 count_;
+        u64 next_;
+        f64 logW_; //!< log of W, the largest key of the sample
+        std::vector<U> samples_;
+    };
+
+    //----------------------------------------------------
+    //---
+    //--- WeightedReservoirSampler
+    //---
+    //----------------------------------------------------
+    /**
+    @brief Sample of k items without replacement in proportion to weights, from a stream
+
+    Each item has the key u^(1/w), and the sample keeps the k largest keys, as logarithms.
+    After the sample is full, a drawn amount of weight is passed without draws.
+    */
+    template<class U>
+    class WeightedReservoirSampler
+    {
+    public:
+        explicit WeightedReservoirSampler(u32 k)
+            :k_(k)
+            ,jump_(0.0)
+        {
+            LASSERT(0<k);
+            heap_.reserve(k);
+        }
+
+        u32 size() const{ return static_cast<u32>(heap_.size());}
+
+        /**
+        @brief The i-th item of the sample, in no order
+        */
+        const U& operator[](u32 i) const{ return heap_[i].second;}
+
+        /**
+        @brief Offer an item of weight, non-positive weights are never sampled
+        */
+        template<class T>
+        void push(T& random, const U& value, f64 weight)
+        {
+            if(weight<=0.0){
+                return;
+            }
+            if(heap_.size()<k_){
+                heap_.push_back(Item(std::log(detail::uniformLeftOpen(random))/weight, value));
+                std::push_heap(heap_.begin(), heap_.end(), Greater());
+                if(heap_.size() == k_){
+                    jump_ = drawJump(random);
+                }
+                return;
+            }
+            jump_ -= weight;
+            if(0.0<jump_){
+                return;
+            }
+            //The new key is above the smallest key of the sample
+            const f64 t = std::exp(weight*heap_.front().first);
+            const f64 r = t + (1.0-t)*detail::uniformRightOpen(random);
+            std::pop_heap(heap_.begin(), heap_.end(), Greater());
+            heap_.back() = Item(std::log(r)/weight, value);
+            std::push_heap(heap_.begin(), heap_.end(), Greater());
+            jump_ = drawJump(random);
+        }
+
+    private:
+        typedef std::pair<f64, U> Item;
+
+        struct Greater
+        {
+            bool operator()(const Item& x0, const Item& x1) const
+            {
+                return x1.first<x0.first;
+            }
+        };
+
+        /**
+        @brief Weight to pass before the next replacement, log(r)/log(T) of the smallest key T
+        */
+        template<class T>
+        f64 drawJump(T& random) const
+        {
+            return std::log(detail::uniformLeftOpen(random))/heap_.front().first;
+        }
+
+        u32 k_;
+        f64 jump_;
+        std::vector<Item> heap_; //!< Min heap of log keys
+    };
+
+    //----------------------------------------------------
+    /**
+    @brief k distinct values of [0, n) by Floyd's algorithm, in k draws
+    @param out ... k values, each subset is equally likely but the order is not random
+    */
+    template<class T>
+    void sampleWithoutReplacement(T& random, u64* out, u32 k, u64 n)
+    {
+        LASSERT(NULL != out || 0 == k);
+        LASSERT(k<=n);
+        std::unordered_set<u64> selected;
+        selected.reserve(k);
+        for(u64 j=n-k; j<n; ++j){
+            u64 t = boundedRandom(random, j+1);
+            if(!selected.insert(t).second){
+                t = j;
+                selected.insert(t);
+            }
+            *out = t;
+            ++out;
+        }
+    }
+}
+#endif //INC_RANDOMSAMPLING_H_
@@ -0,0 +1,273 @@
+#ifndef INC_RANDOMSHUFFLE_H_
+#define INC_RANDOMSHUFFLE_H_
+/**
+@file RandomShuffle.h
+@author t-sakai
+@date 2026/10/17 create
+
+Shuffles for arrays too large for the caches.
+
+shuffleBatched is Fisher-Yates, which draws two swap targets from one value of the generator while they fit,
+and prefetches the targets of the next block while swapping the current one.
+shuffleParallel is MergeShuffle, which shuffles blocks on threads and merges them with random bits.
+Each block and each merge has its own stream of StreamFactory, so the result depends only on the generator and the number of threads.
+*/
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Random.h"
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace lcore
+{
+namespace detail
+{
+    inline void prefetchShuffle(const void* p)
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(p, 1);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+        (void)p;
+#endif
+    }
+
+    /**
+    @brief x in [0, a) and y in [0, b) from one 64 bit value, a*b should not overflow 64 bits
+
+    The value times a gives x at the upper half, and the lower half times b gives y.
+    Rejection of the last lower half against a*b keeps the pair unbiased.
+    */
+    template<class T>
+    inline void boundedPair(T& random, u64 a, u64 b, u64& x, u64& y)
+    {
+        const u64 product = a*b;
+        u64 low;
+        x = mul64(RandomBits<T>::rand64(random), a, low);
+        y = mul64(low, b, low);
+        if(low<product){
+            const u64 threshold = (0ULL-product) % product;
+            while(low<threshold){
+                x = mul64(RandomBits<T>::rand64(random), a, low);
+                y = mul64(low, b, low);
+            }
+        }
+    }
+
+    /**
+    @brief x in [0, a) and y in [0, b) from one 32 bit value, a*b should not overflow 32 bits
+    */
+    template<class T>
+    inline void boundedPair32(T& random, u32 a, u32 b, u64& x, u64& y)
+    {
+        const u32 product = a*b;
+        u64 m = static_cast<u64>(RandomBits<T>::rand32(random)) * a;
+        x = m>>32;
+        m = (m&0xFFFFFFFFULL) * b;
+        if(static_cast<u32>(m)<product){
+            const u32 threshold = (0U-product) % product;
+            while(static_cast<u32>(m)<threshold){
+                m = static_cast<u64>(RandomBits<T>::rand32(random)) * a;
+                x = m>>32;
+                m = (m&0xFFFFFFFFULL) * b;
+            }
+        }
+        y = m>>32;
+    }
+
+    /**
+    @brief indices[k] in [0, top-k] for k in [0, count)
+
+    Two indices share one value of the generator's width while their product fits, one value each otherwise.
+    */
+    template<class T>
+    void shuffleIndices(T& random, u64* indices, u64 top, size_t count)
+    {
+        const u64 PairLimit = (RandomBits<T>::Is64)? 0xFFFFFFFFULL : 0xFFFFULL;
+        size_t k = 0;
+        for(; (k+1)<count; k+=2){
+            const u64 i = top-k;
+            if(PairLimit<=i){
+                indices[k] = boundedRandom(random, i+1);
+                indices[k+1] = boundedRandom(random, i);
+            }else if(RandomBits<T>::Is64){
+                boundedPair(random, i+1, i, indices[k], indices[k+1]);
+            }else{
+                boundedPair32(random, static_cast<u32>(i+1), static_cast<u32>(i), indices[k], indices[k+1]);
+            }
+        }
+        if(k<count){
+            indices[k] = boundedRandom(random, top-k+1);
+        }
+    }
+
+    /**
+    @brief Merge two shuffled runs [0, mid) and [mid, size) into one shuffled run
+
+    Each random bit takes the next value from either run, and the values left after one run ends are inserted by Fisher-Yates.
+    */
+    template<class T, class U>
+    void mergeShuffled(T& random, U* values, size_t mid, size_t size)
+    {
+        size_t i = 0;
+        size_t j = mid;
+        u64 bits = 0;
+        u32 count = 0;
+        for(;;){
+            if(0 == count){
+                bits = RandomBits<T>::rand64(random);
+                count = 64;
+            }
+            const u64 bit = bits&1ULL;
+            bits >>= 1;
+            --count;
+            if(bit){
+                if(j == size){
+                    break;
+                }
+                lcore::swap(values[i], values[j]);
+                ++j;
+            }else{
+                if(i == j){
+                    break;
+                }
+            }
+            ++i;
+        }
+        for(; i<size; ++i){
+            const size_t m = static_cast<size_t>(boundedRandom64(random, i+1));
+            lcore::swap(values[i], values[m]);
+        }
+    }
+
+    /**
+    @brief Call func(i) for i in [0, tasks) on up to threads threads, this thread included
+    */
+    template<class F>
+    void parallelShuffleTasks(u32 threads, u32 tasks, F& func)
+    {
+        threads = (tasks<threads)? tasks : threads;
+        if(threads<=1){
+            for(u32 i=0; i<tasks; ++i){
+                func(i);
+            }
+            return;
+        }
+        std::atomic<u32> next(0);
+        auto work = [&](){
+            for(u32 i=next++; i<tasks; i=next++){
+                func(i);
+            }
+        };
+        std::vector<std::thread> workers;
+        for(u32 i=1; i<threads; ++i){
+            workers.push_back(std::thread(work));
+        }
+        work();
+        for(size_t i=0; i<workers.size(); ++i){
+            workers[i].join();
+        }
+    }
+}
+
+    /**
+    @brief Fisher-Yates shuffle with two swap targets per value of the generator and prefetched targets
+
+    The permutation differs from shuffle with the same generator.
+    */
+    template<class T, class U>
+    void shuffleBatched(T& random, U* values, size_t size)
+    {
+        static const size_t BlockSize = 64;
+        LASSERT(NULL != values || 0 == size);
+        if(size<2){
+            return;
+        }
+        u64 indices[2][BlockSize];
+        u32 current = 0;
+        size_t top = size-1;
+        size_t count = (BlockSize<top)? BlockSize : top;
+        detail::shuffleIndices(random, indices[current], top, count);
+        while(0<count){
+            //Draw and prefetch the next block, while the current block is swapped
+            const size_t nextTop = top-count;
+            const size_t nextCount = (BlockSize<nextTop)? BlockSize : nextTop;
+            if(0<nextCount){
+                u64* next = indices[current^1];
+                detail::shuffleIndices(random, next, nextTop, nextCount);
+                for(size_t k=0; k<nextCount; ++k){
+                    detail::prefetchShuffle(values + next[k]);
+                }
+            }
+            const u64* targets = indices[current];
+            for(size_t k=0; k<count; ++k){
+                lcore::swap(values[top-k], values[targets[k]]);
+            }
+            top = nextTop;
+            count = nextCount;
+            current ^= 1;
+        }
+    }
+
+    /**
+    @brief MergeShuffle on threads, the generator should have jump() for StreamFactory
+    @param random ... the base of the streams, not advanced
+    @param values ...
+    @param size ...
+    @param threads ... number of threads, 0 for hardware concurrency
+
+    The array is split into the power of two blocks not less than threads,
+    so the permutation is the same for the same generator and the same number of threads.
+    */
+    template<class T, class U>
+    void shuffleParallel(const T& random, U* values, size_t size, u32 threads=0)
+    {
+        static const size_t MinBlockSize = 64*1024;
+        LASSERT(NULL != values || 0 == size);
+        threads = (0 == threads)? std::thread::hardware_concurrency() : threads;
+        threads = (threads<1)? 1 : threads;
+        u32 blocks = 1;
+        while(blocks<threads){
+            blocks <<= 1;
+        }
+        if(1 == blocks || size<(blocks*MinBlockSize)){
+            T stream(random);
+            shuffleBatched(stream, values, size);
+            return;
+        }
+
+        //A stream for each block, then for each merge
+        StreamFactory<T> factory(random);
+        std::vector<T> streams;
+        streams.reserve(2*blocks-1);
+        for(u32 i=0; i<(2*blocks-1); ++i){
+            streams.push_back(factory.create());
+        }
+        std::vector<size_t> bounds(blocks+1);
+        for(u32 i=0; i<=blocks; ++i){
+            bounds[i] = static_cast<size_t>(static_cast<u64>(size)*i/blocks);
+        }
+
+        auto shuffleBlock = [&](u32 i){
+            shuffleBatched(streams[i], values+bounds[i], bounds[i+1]-bounds[i]);
+        };
+        detail::parallelShuffleTasks(threads, blocks, shuffleBlock);
+
+        u32 stream = blocks;
+        for(u32 width=1; width<blocks; width<<=1){
+            auto mergeBlocks = [&](u32 i){
+                const size_t start = bounds[2*width*i];
+                const size_t mid = bounds[2*width*i + width];
+                const size_t end = bounds[2*width*(i+1)];
+                detail::mergeShuffled(streams[stream+i], values+start, mid-start, end-start);
+            };
+            const u32 merges = blocks/(2*width);
+            detail::parallelShuffleTasks(threads, merges, mergeBlocks);
+            stream += merges;
+        }
+    }
+}
+#endif //INC_RANDOMSHUFFLE_H_
@@ -0,0 +1,625 @@
+/**
+@file RandomTest.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "RandomTest.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace lcore
+{
+    namespace
+    {
+        //---------------------------------------------
+        inline u32 popcount(u32 x)
+        {
+#if defined(__GNUC__)
+            return static_cast<u32>(__builtin_popcount(x));
+#else
+            x = x - ((x>>1) & 0x55555555U);
+            x = (x & 0x33333333U) + ((x>>2) & 0x33333333U);
+            x = (x + (x>>4)) & 0x0F0F0F0FU;
+            return (x * 0x01010101U)>>24;
+#endif
+        }
+
+        inline u32 parity(u64 x)
+        {
+            x ^= x>>32;
+            x ^= x>>16;
+            x ^= x>>8;
+            x ^= x>>4;
+            x ^= x>>2;
+            x ^= x>>1;
+            return static_cast<u32>(x&1);
+        }
+
+        /**
+        @brief i-th bit of the stream, the most significant bit of a word first
+        */
+        inline u32 getBit(const u32* words, size_t i)
+        {
+            return (words[i>>5] >> (31-(i&31))) & 1U;
+        }
+
+        //---------------------------------------------
+        /**
+        @brief Regularized upper incomplete gamma function Q(a, x)
+        */
+        f64 igamc(f64 a, f64 x)
+        {
+            static const f64 Epsilon = 1.0e-15;
+            static const f64 Tiny = 1.0e-300;
+            if(x<=0.0){
+                return 1.0;
+            }
+            const f64 front = std::exp(-x + a*std::log(x) - std::lgamma(a));
+            if(x<(a+1.0)){
+                //Series of P(a, x)
+                f64 ap = a;
+                f64 term = 1.0/a;
+                f64 sum = term;
+                for(u32 i=0; i<1000; ++i){
+                    ap += 1.0;
+                    term *= x/ap;
+                    sum += term;
+                    if(std::fabs(term)<std::fabs(sum)*Epsilon){
+                        break;
+                    }
+                }
+                return 1.0 - sum*front;
+            }
+            //Continued fraction of Q(a, x) by the modified Lentz's method
+            f64 b = x + 1.0 - a;
+            f64 c = 1.0/Tiny;
+            f64 d = 1.0/b;
+            f64 h = d;
+            for(u32 i=1; i<1000; ++i){
+                f64 an = -static_cast<f64>(i)*(i-a);
+                b += 2.0;
+                d = an*d + b;
+                d = (std::fabs(d)<Tiny)? Tiny : d;
+                c = b + an/c;
+                c = (std::fabs(c)<Tiny)? Tiny : c;
+                d = 1.0/d;
+                f64 delta = d*c;
+                h *= delta;
+                if(std::fabs(delta-1.0)<Epsilon){
+                    break;
+                }
+            }
+            return front*h;
+        }
+
+        /**
+        @brief Bins of zero expectation have no degree of freedom, and a count in one of them rejects
+        */
+        f64 chiSquare(const f64* observed, const f64* expected, u32 size)
+        {
+            f64 chi2 = 0.0;
+            u32 bins = 0;
+            for(u32 i=0; i<size; ++i){
+                if(expected[i]<=0.0){
+                    if(0.0<observed[i]){
+                        return 0.0;
+                    }
+                    continue;
+                }
+                f64 d = observed[i] - expected[i];
+                chi2 += d*d/expected[i];
+                ++bins;
+            }
+            return (bins<=1)? 1.0 : igamc(0.5*(bins-1), 0.5*chi2);
+        }
+
+        /**
+        @brief Kolmogorov-Smirnov test of uniformity of p-values
+        */
+        f64 kolmogorovSmirnov(std::vector<f64> pvalues)
+        {
+            const size_t n = pvalues.size();
+            if(n<=1){
+                return (1==n)? pvalues[0] : 1.0;
+            }
+            std::sort(pvalues.begin(), pvalues.end());
+            f64 d = 0.0;
+            for(size_t i=0; i<n; ++i){
+                f64 upper = static_cast<f64>(i+1)/n - pvalues[i];
+                f64 lower = pvalues[i] - static_cast<f64>(i)/n;
+                d = std::max(d, std::max(upper, lower));
+            }
+            const f64 sqrtn = std::sqrt(static_cast<f64>(n));
+            const f64 lambda = (sqrtn + 0.12 + 0.11/sqrtn)*d;
+            if(lambda<0.2){
+                return 1.0;
+            }
+            f64 sum = 0.0;
+            f64 sign = 1.0;
+            for(u32 k=1; k<=100; ++k){
+                f64 term = sign*std::exp(-2.0*k*k*lambda*lambda);
+                sum += term;
+                if(std::fabs(term)<1.0e-16){
+                    break;
+                }
+                sign = -sign;
+            }
+            return std::min(1.0, std::max(0.0, 2.0*sum));
+        }
+
+        //---------------------------------------------
+        //--- Tests, each returns a p-value of words
+        //---------------------------------------------
+        /**
+        @brief Frequency test of NIST SP 800-22
+        */
+        f64 testMonobit(const u32* words, size_t size, u32)
+        {
+            s64 sum = 0;
+            for(size_t i=0; i<size; ++i){
+                sum += 2*static_cast<s64>(popcount(words[i])) - 32;
+            }
+            const f64 n = 32.0*size;
+            return std::erfc(std::fabs(static_cast<f64>(sum))/std::sqrt(2.0*n));
+        }
+
+        /**
+        @brief Runs test of NIST SP 800-22
+        */
+        f64 testRuns(const u32* words, size_t size, u32)
+        {
+            u64 ones = 0;
+            u64 runs = 1;
+            for(size_t i=0; i<size; ++i){
+                ones += popcount(words[i]);
+                runs += popcount((words[i] ^ (words[i]>>1)) & 0x7FFFFFFFU);
+                if(0<i){
+                    runs += (words[i-1] ^ (words[i]>>31)) & 1U;
+                }
+            }
+            const f64 n = 32.0*size;
+            const f64 pi = ones/n;
+            if(2.0/std::sqrt(n) <= std::fabs(pi-0.5)){
+                return 0.0;
+            }
+            const f64 v = static_cast<f64>(runs);
+            return std::erfc(std::fabs(v - 2.0*n*pi*(1.0-pi))/(2.0*std::sqrt(2.0*n)*pi*(1.0-pi)));
+        }
+
+        /**
+        @brief Gap test of Knuth, lengths of gaps between values in [0, 1/16)
+        */
+        f64 testGap(const u32* words, size_t size, u32)
+        {
+            static const u32 Tail = 64;
+            static const f64 Probability = 1.0/16.0;
+            f64 observed[Tail+1] = {};
+            size_t i = 0;
+            while(i<size && 0 != (words[i]>>28)){
+                ++i;
+            }
+            u32 gap = 0;
+            f64 gaps = 0.0;
+            for(++i; i<size; ++i){
+                if(0 != (words[i]>>28)){
+                    ++gap;
+                    continue;
+                }
+                observed[(gap<Tail)? gap : Tail] += 1.0;
+                gaps += 1.0;
+                gap = 0;
+            }
+            f64 expected[Tail+1];
+            f64 q = 1.0;
+            for(u32 r=0; r<Tail; ++r){
+                expected[r] = gaps*Probability*q;
+                q *= 1.0-Probability;
+            }
+            expected[Tail] = gaps*q;
+            return chiSquare(observed, expected, Tail+1);
+        }
+
+        /**
+        @brief Serial test of NIST SP 800-22, overlapping ntup bit patterns
+        */
+        f64 testSerial(const u32* words, size_t size, u32 ntup)
+        {
+            const u32 m = ntup;
+            const size_t n = 32*size;
+            const u32 mask = (1U<<m) - 1;
+            std::vector<u32> counts(1U<<m, 0);
+            u32 pattern = 0;
+            for(u32 i=0; i<m-1; ++i){
+                pattern = (pattern<<1) | getBit(words, i);
+            }
+            //Patterns wrap around at the end
+            for(size_t i=m-1; i<n+m-1; ++i){
+                pattern = ((pattern<<1) | getBit(words, (i<n)? i : i-n)) & mask;
+                ++counts[pattern];
+            }
+
+            //psi^2 of m, m-1 and m-2 bit patterns, shorter counts are sums over the last bit
+            f64 psi2[3];
+            for(u32 k=0; k<3; ++k){
+                const u32 bits = m-k;
+                f64 sum = 0.0;
+                for(u32 j=0; j<(1U<<bits); ++j){
+                    sum += static_cast<f64>(counts[j])*counts[j];
+                }
+                psi2[k] = (0<bits)? sum*(1U<<bits)/n - static_cast<f64>(n) : 0.0;
+                for(u32 j=0; j<(1U<<(bits-1)) && 1<bits; ++j){
+                    counts[j] = counts[2*j] + counts[2*j+1];
+                }
+            }
+            const f64 delta = psi2[0] - psi2[1];
+            return igamc(static_cast<f64>(1U<<(m-2)), 0.5*delta);
+        }
+
+        /**
+        @brief Birthday spacings test of Marsaglia, 512 birthdays in a year of 2^24 days
+        */
+        f64 testBirthdaySpacings(const u32* words, size_t size, u32)
+        {
+            static const u32 Birthdays = 512;
+            static const u32 Tail = 6;
+            const f64 lambda = static_cast<f64>(Birthdays)*Birthdays*Birthdays/(4.0*(1U<<24));
+            const size_t repetitions = size/Birthdays;
+
+            f64 observed[Tail+1] = {};
+            u32 days[Birthdays];
+            u32 spacings[Birthdays];
+            for(size_t r=0; r<repetitions; ++r){
+                const u32* w = words + r*Birthdays;
+                for(u32 i=0; i<Birthdays; ++i){
+                    days[i] = w[i]>>8;
+                }
+                std::sort(days, days+Birthdays);
+                spacings[0] = days[0];
+                for(u32 i=1; i<Birthdays; ++i){
+                    spacings[i] = days[i] - days[i-1];
+                }
+                std::sort(spacings, spacings+Birthdays);
+                u32 repeats = 0;
+                for(u32 i=1; i<Birthdays; ++i){
+                    repeats += (spacings[i] == spacings[i-1])? 1 : 0;
+                }
+                observed[(repeats<Tail)? repeats : Tail] += 1.0;
+            }
+
+            f64 expected[Tail+1];
+            f64 poisson = std::exp(-lambda);
+            f64 sum = 0.0;
+            for(u32 i=0; i<Tail; ++i){
+                expected[i] = repetitions*poisson;
+                sum += poisson;
+                poisson *= lambda/(i+1);
+            }
+            expected[Tail] = repetitions*(1.0-sum);
+            return chiSquare(observed, expected, Tail+1);
+        }
+
+        u32 getRank32x32(u32 rows[32])
+        {
+            u32 rank = 0;
+            for(u32 bit=0; bit<32 && rank<32; ++bit){
+                const u32 mask = 0x80000000U>>bit;
+                u32 pivot = rank;
+                while(pivot<32 && 0 == (rows[pivot]&mask)){
+                    ++pivot;
+                }
+                if(32<=pivot){
+                    continue;
+                }
+                std::swap(rows[rank], rows[pivot]);
+                for(u32 i=rank+1; i<32; ++i){
+                    if(rows[i]&mask){
+                        rows[i] ^= rows[rank];
+                    }
+                }
+                ++rank;
+            }
+            return rank;
+        }
+
+        /**
+        @brief Probability that a random n x n matrix over GF(2) has rank r
+        */
+        f64 getRankProbability(u32 n, u32 r)
+        {
+            f64 p = std::pow(2.0, static_cast<f64>(r)*(2.0*n-r) - static_cast<f64>(n)*n);
+            for(u32 i=0; i<r; ++i){
+                f64 a = 1.0 - std::pow(2.0, static_cast<f64>(i)-n);
+                p *= a*a/(1.0 - std::pow(2.0, static_cast<f64>(i)-r));
+            }
+            return p;
+        }
+
+        /**
+        @brief Binary rank test of 32 x 32 matrices
+        */
+        f64 testMatrixRank(const u32* words, size_t size, u32)
+        {
+            const size_t matrices = size/32;
+            f64 observed[4] = {};
+            u32 rows[32];
+            for(size_t i=0; i<matrices; ++i){
+                for(u32 j=0; j<32; ++j){
+                    rows[j] = words[i*32+j];
+                }
+                u32 rank = getRank32x32(rows);
+                observed[(rank<=29)? 3 : 32-rank] += 1.0;
+            }
+            f64 expected[4];
+            expected[0] = getRankProbability(32, 32);
+            expected[1] = getRankProbability(32, 31);
+            expected[2] = getRankProbability(32, 30);
+            expected[3] = 1.0 - expected[0] - expected[1] - expected[2];
+            for(u32 i=0; i<4; ++i){
+                expected[i] *= matrices;
+            }
+            return chiSquare(observed, expected, 4);
+        }
+
+        /**
+        @brief Linear complexity of bits [start, start+BlockBits) by Berlekamp-Massey over 64 bit words
+        */
+        static const u32 LinearComplexityBlockBits = 500;
+        static const u32 LinearComplexityWords = (LinearComplexityBlockBits+63)/64;
+
+        void xorShifted(u64 dst[LinearComplexityWords], const u64 src[LinearComplexityWords], u32 shift)
+        {
+            const u32 wordShift = shift>>6;
+            const u32 bitShift = shift&63;
+            for(u32 i=LinearComplexityWords; wordShift<i; --i){
+                const u32 j = i-1-wordShift;
+                u64 x = src[j]<<bitShift;
+                if(0<bitShift && 0<j){
+                    x |= src[j-1]>>(64-bitShift);
+                }
+                dst[i-1] ^= x;
+            }
+        }
+
+        u32 getLinearComplexity(const u32* words, size_t start)
+        {
+            //window bit i holds s[N-i], so the discrepancy is the parity of c & window
+            u64 c[LinearComplexityWords] = {1};
+            u64 b[LinearComplexityWords] = {1};
+            u64 window[LinearComplexityWords] = {};
+            u32 l = 0;
+            s32 m = -1;
+            for(u32 n=0; n<LinearComplexityBlockBits; ++n){
+                for(u32 i=LinearComplexityWords-1; 0<i; --i){
+                    window[i] = (window[i]<<1) | (window[i-1]>>63);
+                }
+                window[0] = (window[0]<<1) | getBit(words, start+n);
+
+                u64 d = 0;
+                for(u32 i=0; i<LinearComplexityWords; ++i){
+                    d ^= c[i] & window[i];
+                }
+                if(0 == parity(d)){
+                    continue;
+                }
+                u64 t[LinearComplexityWords];
+                for(u32 i=0; i<LinearComplexityWords; ++i){
+                    t[i] = c[i];
+                }
+                xorShifted(c, b, static_cast<u32>(static_cast<s32>(n)-m));
+                if(2*l<=n){
+                    l = n+1-l;
+                    m = static_cast<s32>(n);
+                    for(u32 i=0; i<LinearComplexityWords; ++i){
+                        b[i] = t[i];
+                    }
+                }
+            }
+            return l;
+        }
+
+        /**
+        @brief Linear complexity test of NIST SP 800-22, blocks of 500 bits
+        */
+        f64 testLinearComplexity(const u32* words, size_t size, u32)
+        {
+            static const f64 Probabilities[7] = {0.010417, 0.03125, 0.125, 0.5, 0.25, 0.0625, 0.020833};
+            const f64 m = LinearComplexityBlockBits;
+            const size_t blocks = 32*size/LinearComplexityBlockBits;
+            const f64 sign = (LinearComplexityBlockBits&1)? -1.0 : 1.0;
+            const f64 mu = 0.5*m + (9.0 - sign)/36.0 - (m/3.0 + 2.0/9.0)/std::pow(2.0, m);
+
+            f64 observed[7] = {};
+            for(size_t i=0; i<blocks; ++i){
+                u32 l = getLinearComplexity(words, i*LinearComplexityBlockBits);
+                f64 t = sign*(l-mu) + 2.0/9.0;
+                u32 category;
+                if(t<=-2.5){
+                    category = 0;
+                }else if(t<=-1.5){
+                    category = 1;
+                }else if(t<=-0.5){
+                    category = 2;
+                }else if(t<=0.5){
+                    category = 3;
+                }else if(t<=1.5){
+                    category = 4;
+                }else if(t<=2.5){
+                    category = 5;
+                }else{
+                    category = 6;
+                }
+                observed[category] += 1.0;
+            }
+            f64 expected[7];
+            for(u32 i=0; i<7; ++i){
+                expected[i] = blocks*Probabilities[i];
+            }
+            return chiSquare(observed, expected, 7);
+        }
+
+        //---------------------------------------------
+        struct RandomTest
+        {
+            const Char* name_;
+            u32 ntup_;
+            u32 tsamples_;
+            size_t words_; //!< Words consumed by a p-value
+            f64 (*test_)(const u32* words, size_t size, u32 ntup);
+        };
+
+        static const RandomTest RandomTests[] =
+        {
+            {"monobit", 0, 1000000, 31250, testMonobit},
+            {"runs", 0, 1000000, 31250, testRuns},
+            {"gap", 0, 1U<<20, 1U<<20, testGap},
+            {"serial", 4, 1U<<20, 1U<<15, testSerial},
+            {"serial", 8, 1U<<20, 1U<<15, testSerial},
+            {"serial", 12, 1U<<20, 1U<<15, testSerial},
+            {"serial", 16, 1U<<20, 1U<<15, testSerial},
+            {"birthday_spacings", 0, 500, 512*500, testBirthdaySpacings},
+            {"rank_32x32", 0, 40000, 32*40000, testMatrixRank},
+            {"linear_complexity", 0, 2000, 31250, testLinearComplexity},
+        };
+        static const u32 NumRandomTests = sizeof(RandomTests)/sizeof(RandomTests[0]);
+    }
+
+    //---------------------------------------------
+    void runRandomTests(std::vector<RandomTestResult>& results, RandomTestSource& source, u32 psamples, u32 threads)
+    {
+        psamples = (psamples<1)? 1 : psamples;
+        threads = (0 == threads)? std::thread::hardware_concurrency() : threads;
+        threads = (threads<1)? 1 : threads;
+
+        size_t maxWords = 0;
+        for(u32 i=0; i<NumRandomTests; ++i){
+            maxWords = std::max(maxWords, RandomTests[i].words_);
+        }
+
+        //This thread reads the source in order into free buffers, and workers test them
+        struct Job
+        {
+            u32 test_;
+            u32 sample_;
+            u32* words_;
+        };
+        std::vector<std::vector<u32> > buffers(2*threads, std::vector<u32>(maxWords));
+        std::vector<u32*> freeBuffers;
+        for(size_t i=0; i<buffers.size(); ++i){
+            freeBuffers.push_back(&buffers[i][0]);
+        }
+        std::vector<Job> jobs;
+        std::vector<f64> pvalues(NumRandomTests*psamples);
+        bool done = false;
+        std::mutex mutex;
+        std::condition_variable condition;
+
+        std::vector<std::thread> workers;
+        for(u32 i=0; i<threads; ++i){
+            workers.push_back(std::thread([&](){
+                for(;;){
+                    Job job;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        condition.wait(lock, [&](){ return done || !jobs.empty();});
+                        if(jobs.empty()){
+                            return;
+                        }
+                        job = jobs.back();
+                        jobs.pop_back();
+                    }
+                    const RandomTest& test = RandomTests[job.test_];
+                    f64 pvalue = test.test_(job.words_, test.words_, test.ntup_);
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        pvalues[job.test_*psamples + job.sample_] = pvalue;
+                        freeBuffers.push_back(job.words_);
+                    }
+                    condition.notify_all();
+                }
+            }));
+        }
+
+        for(u32 sample=0; sample<psamples; ++sample){
+            for(u32 test=0; test<NumRandomTests; ++test){
+                u32* words;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock, [&](){ return !freeBuffers.empty();});
+                    words = freeBuffers.back();
+                    freeBuffers.pop_back();
+                }
+                source.fill(words, RandomTests[test].words_);
+                Job job = {test, sample, words};
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    jobs.push_back(job);
+                }
+                condition.notify_all();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        condition.notify_all();
+        for(size_t i=0; i<workers.size(); ++i){
+            workers[i].join();
+        }
+
+        results.clear();
+        for(u32 i=0; i<NumRandomTests; ++i){
+            const RandomTest& test = RandomTests[i];
+            RandomTestResult result;
+            result.name_ = test.name_;
+            result.ntup_ = test.ntup_;
+            result.tsamples_ = test.tsamples_;
+            result.psamples_ = psamples;
+            result.pvalue_ = kolmogorovSmirnov(std::vector<f64>(pvalues.begin()+i*psamples, pvalues.begin()+(i+1)*psamples));
+            result.assessment_ = getRandomTestAssessment(result.pvalue_);
+            results.push_back(result);
+        }
+    }
+
+    RandomTestAssessment getRandomTestAssessment(f64 pvalue)
+    {
+        //NaN of a broken statistic compares false, so it is out of [0, 1] here
+        if(!(0.0<=pvalue && pvalue<=1.0)){
+            return RandomTestAssessment_Failed;
+        }
+        //The same thresholds as the Dieharder
+        if(pvalue<1.0e-6 || (1.0-1.0e-6)<pvalue){
+            return RandomTestAssessment_Failed;
+        }
+        if(pvalue<0.005 || 0.995<pvalue){
+            return RandomTestAssessment_Weak;
+        }
+        return RandomTestAssessment_Passed;
+    }
+
+    const Char* getRandomTestAssessmentName(RandomTestAssessment assessment)
+    {
+        static const Char* names[] = {"PASSED", "WEAK", "FAILED"};
+        return names[assessment];
+    }
+
+    void printRandomTestResults(FILE* file, const Char* name, const std::vector<RandomTestResult>& results, bool notPassedOnly, bool header)
+    {
+        if(header){
+            fprintf(file, "|Name|Test Name|ntup|tsamples|psamples|p-value|Assessment|\n");
+            fprintf(file, "|:---|---:|---:|---:|---:|---:|---:|\n");
+        }
+        fprintf(file, "|%s| | | | | | |\n", name);
+        for(size_t i=0; i<results.size(); ++i){
+            const RandomTestResult& result = results[i];
+            if(notPassedOnly && RandomTestAssessment_Passed == result.assessment_){
+                continue;
+            }
+            fprintf(file, "||%s|%4u|%10u|%8u|%10.8f|%7s|\n",
+                result.name_, result.ntup_, result.tsamples_, result.psamples_, result.pvalue_,
+                getRandomTestAssessmentName(result.assessment_));
+        }
+    }
+}
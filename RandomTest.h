@@ -0,0 +1,71 @@
+#ifndef INC_RANDOMTEST_H_
+#define INC_RANDOMTEST_H_
+/**
+@file RandomTest.h
+@author t-sakai
+@date 2026/10/17 create
+
+Statistical tests run in memory on generator output.
+
+Each test computes psamples p-values, each from its own consecutive part of the output, in parallel,
+and the final p-value is the Kolmogorov-Smirnov test of their uniformity, as the Dieharder does.
+The output is consumed in a fixed order, so the results depend only on the source, not on the number of threads.
+*/
+#include <cstdio>
+#include <vector>
+#include "Random.h"
+
+namespace lcore
+{
+    /**
+    @brief Output of a generator as a sequence of 32 bit words
+    */
+    class RandomTestSource
+    {
+    public:
+        virtual ~RandomTestSource()
+        {}
+
+        virtual void fill(u32* words, size_t size) = 0;
+    };
+
+    enum RandomTestAssessment
+    {
+        RandomTestAssessment_Passed = 0,
+        RandomTestAssessment_Weak,
+        RandomTestAssessment_Failed,
+    };
+
+    struct RandomTestResult
+    {
+        const Char* name_;
+        u32 ntup_;
+        u32 tsamples_; //!< Number of samples of a p-value
+        u32 psamples_; //!< Number of p-values
+        f64 pvalue_;
+        RandomTestAssessment assessment_;
+    };
+
+    /**
+    @brief Run monobit, runs, gap, serial, birthday spacings, matrix rank and linear complexity tests
+    @param results ... one result for each test
+    @param source ...
+    @param psamples ... number of p-values of each test
+    @param threads ... number of worker threads, 0 for hardware concurrency
+    */
+    void runRandomTests(std::vector<RandomTestResult>& results, RandomTestSource& source, u32 psamples=100, u32 threads=0);
+
+    RandomTestAssessment getRandomTestAssessment(f64 pvalue);
+    const Char* getRandomTestAssessmentName(RandomTestAssessment assessment);
+
+    /**
+    @brief Print results as a row of the README table
+    @param file ...
+    @param name ... name of the generator
+    @param results ...
+    @param notPassedOnly ... print only weak or failed tests
+    @param header ... print the table header before rows
+    */
+    void printRandomTestResults(FILE* file, const Char* name, const std::vector<RandomTestResult>& results, bool notPassedOnly, bool header);
+}
+#endif //INC_RANDOMTEST_H_
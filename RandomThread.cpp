@@ -0,0 +1,93 @@
+/**
+@file RandomThread.cpp
+@author t-sakai
+@date 2026/10/17 create
+*/
+#include "RandomThread.h"
+#include <mutex>
+
+namespace lcore
+{
+    namespace
+    {
+        struct ThreadStreams
+        {
+            ThreadStreams()
+                :seeded_(false)
+                ,factory_(ThreadRandomGenerator())
+            {}
+
+            void seed(u64 seed)
+            {
+                ThreadRandomGenerator base;
+                seedSplitMix64(base, seed);
+                factory_ = StreamFactory<ThreadRandomGenerator>(base);
+                seeded_ = true;
+            }
+
+            ThreadRandomGenerator create()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if(!seeded_){
+                    seed(getDefaultSeed64());
+                }
+                return factory_.create();
+            }
+
+            std::mutex mutex_;
+            bool seeded_;
+            StreamFactory<ThreadRandomGenerator> factory_;
+        };
+
+        ThreadStreams& getThreadStreams()
+        {
+            static ThreadStreams streams;
+            return streams;
+        }
+
+        /**
+        @brief A line of its own, so that neighboring thread blocks do not share the state
+        */
+        struct alignas(64) ThreadRandom
+        {
+            ThreadRandom()
+                :random_(getThreadStreams().create())
+            {}
+
+            ThreadRandomGenerator random_;
+        };
+    }
+
+    ThreadRandomGenerator& threadRandom()
+    {
+        static thread_local ThreadRandom random;
+        return random.random_;
+    }
+
+    void setThreadRandomSeed(u64 seed)
+    {
+        ThreadStreams& streams = getThreadStreams();
+        std::lock_guard<std::mutex> lock(streams.mutex_);
+        streams.seed(seed);
+    }
+
+    u32 threadRand()
+    {
+        return threadRandom().rand();
+    }
+
+    f32 threadFrand()
+    {
+        return threadRandom().frand();
+    }
+
+    f32 threadFrand2()
+    {
+        return threadRandom().frand2();
+    }
+
+    f64 threadDrand2()
+    {
+        return threadRandom().drand2();
+    }
+}
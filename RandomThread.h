@@ -0,0 +1,72 @@
+#ifndef INC_RANDOMTHREAD_H_
+#define INC_RANDOMTHREAD_H_
+/**
+@file RandomThread.h
+@author t-sakai
+@date 2026/10/17 create
+
+A generator for each thread, created on the first use in the thread.
+
+The generators are the streams of one StreamFactory, so no two threads share a part of a sequence.
+The base is seeded once for the process by getDefaultSeed64(), or by setThreadRandomSeed.
+Only the creation of a generator takes a lock, and the draws never do.
+
+    u32 index = threadRange_ropen(0U, count);
+*/
+#include "Random.h"
+
+namespace lcore
+{
+    typedef Xoshiro128Plus ThreadRandomGenerator;
+
+    /**
+    @brief The generator of the calling thread, each stream owns 16*2^64 values
+    */
+    ThreadRandomGenerator& threadRandom();
+
+    /**
+    @brief Seed the base of the streams, which gives the same streams in the order of creation
+
+    Generators already created keep their streams.
+    */
+    void setThreadRandomSeed(u64 seed);
+
+    /**
+    @brief [0 0xFFFFFFFFU]
+    */
+    u32 threadRand();
+
+    /**
+    @brief (0, 1]
+    */
+    f32 threadFrand();
+
+    /**
+    @brief [0, 1)
+    */
+    f32 threadFrand2();
+
+    /**
+    @brief [0, 1) of 53 bits
+    */
+    f64 threadDrand2();
+
+    /**
+    @brief [vmin, vmax)
+    */
+    template<class U>
+    U threadRange_ropen(U vmin, U vmax)
+    {
+        return range_ropen(threadRandom(), vmin, vmax);
+    }
+
+    /**
+    @brief [vmin, vmax]
+    */
+    template<class U>
+    U threadRange_rclose(U vmin, U vmax)
+    {
+        return range_rclose(threadRandom(), vmin, vmax);
+    }
+}
+#endif //INC_RANDOMTHREAD_H_
@@ -0,0 +1,752 @@
+/**
+@file Bench.cpp
+@author t-sakai
+@date 2026/10/17 create
+
+TestRandomBench [--reps N] [--warmup N] [--time seconds] [--filter text] [--csv file] [--json file]
+*/
+#include "Random.h"
+#include "RandomKernel.h"
+#include "RandomCounter.h"
+#include "RandomDistribution.h"
+#include "RandomEngine.h"
+#include "RandomPermutation.h"
+#include "RandomPrefetch.h"
+#include "RandomRegistry.h"
+#include "RandomSampling.h"
+#include "RandomShuffle.h"
+#include "RandomThread.h"
+#include "PerfCounter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace
+{
+    using namespace lcore;
+
+    volatile u64 sink_ = 0;
+
+    inline u64 getCycles()
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    inline u64 sink(u32 x)
+    {
+        return x;
+    }
+
+    inline u64 sink(u64 x)
+    {
+        return x;
+    }
+
+    inline u64 sink(f32 x)
+    {
+        return static_cast<u64>(x*4294967296.0f);
+    }
+
+    inline u64 sink(f64 x)
+    {
+        return static_cast<u64>(x*18446744073709551616.0);
+    }
+
+    //---------------------------------------------
+    struct Statistics
+    {
+        f64 median_;
+        f64 min_;
+        f64 max_;
+        f64 mean_;
+        f64 stddev_;
+    };
+
+    Statistics getStatistics(std::vector<f64> values)
+    {
+        Statistics statistics = {};
+        if(values.empty()){
+            return statistics;
+        }
+        std::sort(values.begin(), values.end());
+        size_t n = values.size();
+        statistics.median_ = (n&1)? values[n/2] : 0.5*(values[n/2-1] + values[n/2]);
+        statistics.min_ = values[0];
+        statistics.max_ = values[n-1];
+        f64 sum = 0.0;
+        for(size_t i=0; i<n; ++i){
+            sum += values[i];
+        }
+        statistics.mean_ = sum/n;
+        f64 variance = 0.0;
+        for(size_t i=0; i<n; ++i){
+            variance += (values[i]-statistics.mean_)*(values[i]-statistics.mean_);
+        }
+        statistics.stddev_ = (1<n)? std::sqrt(variance/(n-1)) : 0.0;
+        return statistics;
+    }
+
+    struct Result
+    {
+        std::string name_;
+        u32 bytesPerValue_;
+        u64 iterations_;
+        Statistics nanoseconds_; //!< per value
+        f64 cyclesPerByte_; //!< median, in time stamp counter cycles
+    };
+
+    //---------------------------------------------
+    class Benchmark
+    {
+    public:
+        Benchmark()
+            :warmups_(3)
+            ,repetitions_(15)
+            ,seconds_(0.01)
+            ,filter_(NULL)
+        {}
+
+        u32 warmups_;
+        u32 repetitions_;
+        f64 seconds_; //!< Minimum time of a repetition
+        const Char* filter_;
+
+        /**
+        @brief Measure func(count), which generates count values and returns something depending on them
+        */
+        template<class F>
+        void run(const std::string& name, u32 bytesPerValue, F func)
+        {
+            if(NULL != filter_ && std::string::npos == name.find(filter_)){
+                return;
+            }
+            typedef std::chrono::steady_clock clock;
+
+            //Calibrate the number of values of a repetition
+            u64 count = 1024;
+            for(;;){
+                clock::time_point start = clock::now();
+                sink_ += func(count);
+                f64 seconds = std::chrono::duration<f64>(clock::now() - start).count();
+                if(seconds_<=seconds || (1ULL<<40)<=count){
+                    break;
+                }
+                count *= (seconds*8.0<seconds_)? 8 : 2;
+            }
+            for(u32 i=0; i<warmups_; ++i){
+                sink_ += func(count);
+            }
+
+            std::vector<f64> nanoseconds;
+            std::vector<f64> cycles;
+            for(u32 i=0; i<repetitions_; ++i){
+                clock::time_point start = clock::now();
+                u64 startCycles = getCycles();
+                sink_ += func(count);
+                u64 endCycles = getCycles();
+                f64 seconds = std::chrono::duration<f64>(clock::now() - start).count();
+                nanoseconds.push_back(seconds*1.0e9/count);
+                cycles.push_back(static_cast<f64>(endCycles-startCycles)/(static_cast<f64>(count)*bytesPerValue));
+            }
+
+            //One more repetition for hardware counters, apart from the timed ones
+            {
+                LCORE_PERF_SCOPE(name.c_str(), count);
+                sink_ += func(count);
+            }
+
+            Result result;
+            result.name_ = name;
+            result.bytesPerValue_ = bytesPerValue;
+            result.iterations_ = count;
+            result.nanoseconds_ = getStatistics(nanoseconds);
+            result.cyclesPerByte_ = getStatistics(cycles).median_;
+            results_.push_back(result);
+            printf("%-36s %10.3f %10.3f %10.3f %8.2f%% %10.3f\n",
+                name.c_str(),
+                result.nanoseconds_.median_,
+                result.nanoseconds_.min_,
+                result.nanoseconds_.mean_,
+                (0.0<result.nanoseconds_.mean_)? 100.0*result.nanoseconds_.stddev_/result.nanoseconds_.mean_ : 0.0,
+                result.cyclesPerByte_);
+            fflush(stdout);
+        }
+
+        const std::vector<Result>& getResults() const
+        {
+            return results_;
+        }
+
+    private:
+        std::vector<Result> results_;
+    };
+
+    //---------------------------------------------
+    static const u32 BufferSize = 4096;
+
+    template<class T, class U>
+    u64 fillBuffered(T& random, u64 count, void (T::*fill)(U*, size_t))
+    {
+        static U buffer[BufferSize];
+        u64 s = 0;
+        while(0<count){
+            size_t n = (BufferSize<count)? BufferSize : static_cast<size_t>(count);
+            (random.*fill)(buffer, n);
+            s += sink(buffer[n-1]);
+            count -= n;
+        }
+        return s;
+    }
+
+    /**
+    @brief Same as fillBuffered, for fill(random, buffer, n) of a distribution
+    */
+    template<class U, class D, class T>
+    u64 fillDistribution(const D& distribution, T& random, u64 count)
+    {
+        static U buffer[BufferSize];
+        u64 s = 0;
+        while(0<count){
+            size_t n = (BufferSize<count)? BufferSize : static_cast<size_t>(count);
+            distribution.fill(random, buffer, n);
+            s += sink(buffer[n-1]);
+            count -= n;
+        }
+        return s;
+    }
+
+    template<class T>
+    void bench32(Benchmark& benchmark, const Char* name)
+    {
+        std::string prefix(name);
+        T random(getStaticSeed());
+        benchmark.run(prefix+"::rand", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += random.rand();
+            }
+            return s;
+        });
+        benchmark.run(prefix+"::frand", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += sink(random.frand());
+            }
+            return s;
+        });
+        benchmark.run(prefix+"::frand2", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += sink(random.frand2());
+            }
+            return s;
+        });
+        benchmark.run(prefix+"::fill", 4, [&](u64 count){
+            return fillBuffered<T, u32>(random, count, &T::fill);
+        });
+        benchmark.run(prefix+"::ffill2", 4, [&](u64 count){
+            return fillBuffered<T, f32>(random, count, &T::ffill2);
+        });
+        benchmark.run(prefix+"::drand2", 8, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += sink(random.drand2());
+            }
+            return s;
+        });
+        benchmark.run(prefix+"::dfill2", 8, [&](u64 count){
+            return fillBuffered<T, f64>(random, count, &T::dfill2);
+        });
+    }
+
+    template<class T>
+    void bench64(Benchmark& benchmark, const Char* name)
+    {
+        std::string prefix(name);
+        T random(getStaticSeed64());
+        benchmark.run(prefix+"::rand", 8, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += random.rand();
+            }
+            return s;
+        });
+        benchmark.run(prefix+"::drand2", 8, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += sink(random.drand2());
+            }
+            return s;
+        });
+    }
+
+    template<class T>
+    void benchCounter(Benchmark& benchmark, const Char* name)
+    {
+        std::string prefix(name);
+        T random(getStaticSeed64());
+        benchmark.run(prefix+"::rand", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += random.rand();
+            }
+            return s;
+        });
+        benchmark.run(prefix+"::frand2", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += sink(random.frand2());
+            }
+            return s;
+        });
+        benchmark.run(prefix+"::at", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += random.at(i);
+            }
+            return s;
+        });
+        benchmark.run(prefix+"::fill", 4, [&](u64 count){
+            return fillBuffered<T, u32>(random, count, &T::fill);
+        });
+        benchmark.run(prefix+"::ffill2", 4, [&](u64 count){
+            return fillBuffered<T, f32>(random, count, &T::ffill2);
+        });
+    }
+
+    template<class T>
+    void benchStd(Benchmark& benchmark, const Char* name)
+    {
+        std::string prefix(name);
+        T random(getStaticSeed());
+        benchmark.run(prefix+"::operator()", sizeof(typename T::result_type), [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += random();
+            }
+            return s;
+        });
+        std::uniform_real_distribution<f32> distribution(0.0f, 1.0f);
+        benchmark.run(prefix+"::uniform_real_distribution<f32>", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += sink(distribution(random));
+            }
+            return s;
+        });
+    }
+
+    /**
+    @brief Every generator of the registry through the same dispatch, to compare the engines on one workload
+    */
+    void benchRegistry(Benchmark& benchmark)
+    {
+        for(u32 i=0; i<getNumRandomGenerators(); ++i){
+            const RandomGeneratorInfo& info = getRandomGeneratorInfo(i);
+            std::string prefix = std::string("AnyRandom(")+info.name_+")";
+            AnyRandom random(info, getStaticSeed64());
+            benchmark.run(prefix+"::fill", 4, [&](u64 count){
+                return fillBuffered<AnyRandom, u32>(random, count, &AnyRandom::fill);
+            });
+            benchmark.run(prefix+"::dfill", 8, [&](u64 count){
+                return fillBuffered<AnyRandom, f64>(random, count, &AnyRandom::dfill);
+            });
+        }
+    }
+
+    void benchDistributions(Benchmark& benchmark)
+    {
+        Xoshiro128Plus random(getStaticSeed());
+        benchmark.run("Box-Muller(frand2)", 8, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; i+=2){
+                f64 r = std::sqrt(-2.0*std::log(1.0-random.frand2()));
+                f64 theta = 6.283185307179586*random.frand2();
+                s += sink(r*std::cos(theta)) + sink(r*std::sin(theta));
+            }
+            return s;
+        });
+        NormalDistribution normal;
+        benchmark.run("NormalDistribution::drand", 8, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += sink(normal.drand(random));
+            }
+            return s;
+        });
+        benchmark.run("NormalDistribution::fill(f32)", 4, [&](u64 count){
+            return fillDistribution<f32>(normal, random, count);
+        });
+        benchmark.run("NormalDistribution::fill(f64)", 8, [&](u64 count){
+            return fillDistribution<f64>(normal, random, count);
+        });
+        ExponentialDistribution exponential;
+        benchmark.run("ExponentialDistribution::drand", 8, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += sink(exponential.drand(random));
+            }
+            return s;
+        });
+        benchmark.run("ExponentialDistribution::fill(f64)", 8, [&](u64 count){
+            return fillDistribution<f64>(exponential, random, count);
+        });
+
+        PoissonDistribution poisson(1000.0);
+        benchmark.run("PoissonDistribution(1000)::rand", 8, [&](u64 count){
+            return fillDistribution<u64>(poisson, random, count);
+        });
+        BinomialDistribution binomial(1000, 0.3);
+        benchmark.run("BinomialDistribution(1000, 0.3)::rand", 8, [&](u64 count){
+            return fillDistribution<u64>(binomial, random, count);
+        });
+        GeometricDistribution geometric(0.1);
+        benchmark.run("GeometricDistribution(0.1)::rand", 8, [&](u64 count){
+            return fillDistribution<u64>(geometric, random, count);
+        });
+
+        std::vector<f64> weights(1000000);
+        for(size_t i=0; i<weights.size(); ++i){
+            weights[i] = 1.0 + static_cast<f64>(i%97);
+        }
+        AliasTable aliasTable(&weights[0], static_cast<u32>(weights.size()));
+        benchmark.run("AliasTable(1M)::rand", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += aliasTable.rand(random);
+            }
+            return s;
+        });
+        benchmark.run("AliasTable(1M)::fill", 4, [&](u64 count){
+            return fillDistribution<u32>(aliasTable, random, count);
+        });
+    }
+
+    void benchHelpers(Benchmark& benchmark)
+    {
+        Xoshiro128Plus random(getStaticSeed());
+        benchmark.run("range_ropen<u32>(0, 1000)", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += range_ropen(random, 0U, 1000U);
+            }
+            return s;
+        });
+        benchmark.run("range_rclose<s32>(-100, 100)", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += range_rclose(random, -100, 100);
+            }
+            return s;
+        });
+        benchmark.run("threadRand", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += threadRand();
+            }
+            return s;
+        });
+        benchmark.run("threadRange_ropen<u32>(0, 1000)", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += threadRange_ropen(0U, 1000U);
+            }
+            return s;
+        });
+        {
+            PrefetchedRandom<Xoshiro128Plus> prefetched((Xoshiro128Plus(getStaticSeed())));
+            benchmark.run("PrefetchedRandom<Xoshiro128Plus>::rand", 4, [&](u64 count){
+                u64 s = 0;
+                for(u64 i=0; i<count; ++i){
+                    s += prefetched.rand();
+                }
+                return s;
+            });
+            benchmark.run("PrefetchedRandom<Xoshiro128Plus>::fill", 4, [&](u64 count){
+                return fillBuffered<PrefetchedRandom<Xoshiro128Plus>, u32>(prefetched, count, &PrefetchedRandom<Xoshiro128Plus>::fill);
+            });
+        }
+        benchmark.run("getDefaultSeed64", 8, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += getDefaultSeed64();
+            }
+            return s;
+        });
+        std::vector<Xoshiro128Plus> generators(4096);
+        benchmark.run("seedMany<Xoshiro128Plus>", 16, [&](u64 count){
+            u64 s = 0;
+            while(0<count){
+                u64 n = (generators.size()<count)? generators.size() : count;
+                seedMany(&generators[0], static_cast<size_t>(n), s);
+                s += generators[0].rand();
+                count -= n;
+            }
+            return s;
+        });
+        std::vector<u32> indices(4096);
+        benchmark.run("range_ropen<u32>(0, 1000) batch", 4, [&](u64 count){
+            u64 s = 0;
+            while(0<count){
+                u64 n = (indices.size()<count)? indices.size() : count;
+                range_ropen(random, &indices[0], static_cast<size_t>(n), 0U, 1000U);
+                s += indices[0];
+                count -= n;
+            }
+            return s;
+        });
+        benchmark.run("range_ropen<f32>(-1, 1)", 4, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += sink(range_ropen(random, -1.0f, 1.0f));
+            }
+            return s;
+        });
+
+        //Per element
+        std::vector<u32> values(1024*1024);
+        for(u32 i=0; i<values.size(); ++i){
+            values[i] = i;
+        }
+        benchmark.run("shuffle(1M u32)", 4, [&](u64 count){
+            u64 s = 0;
+            while(0<count){
+                u64 n = (values.size()<count)? values.size() : count;
+                shuffle(random, &values[0], &values[0]+n);
+                s += values[0];
+                count -= n;
+            }
+            return s;
+        });
+        benchmark.run("shuffleBatched(1M u32)", 4, [&](u64 count){
+            u64 s = 0;
+            while(0<count){
+                u64 n = (values.size()<count)? values.size() : count;
+                shuffleBatched(random, &values[0], n);
+                s += values[0];
+                count -= n;
+            }
+            return s;
+        });
+        benchmark.run("shuffleParallel(1M u32)", 4, [&](u64 count){
+            u64 s = 0;
+            while(0<count){
+                u64 n = (values.size()<count)? values.size() : count;
+                shuffleParallel(random, &values[0], n);
+                s += values[0];
+                count -= n;
+            }
+            return s;
+        });
+
+        RandomPermutation permutation(random, 1000000000ULL);
+        benchmark.run("RandomPermutation[](1G)", 8, [&](u64 count){
+            u64 s = 0;
+            for(u64 i=0; i<count; ++i){
+                s += permutation[i%permutation.size()];
+            }
+            return s;
+        });
+        std::vector<u64> permuted(4096);
+        benchmark.run("RandomPermutation::fill(1G)", 8, [&](u64 count){
+            u64 s = 0;
+            u64 start = 0;
+            while(0<count){
+                u64 n = (permuted.size()<count)? permuted.size() : count;
+                start = ((permutation.size()-n)<start)? 0 : start;
+                permutation.fill(&permuted[0], start, static_cast<size_t>(n));
+                s += permuted[0];
+                start += n;
+                count -= n;
+            }
+            return s;
+        });
+
+        //Per stream element
+        benchmark.run("ReservoirSampler(k=1000)::push", 4, [&](u64 count){
+            ReservoirSampler<u64> sampler(1000);
+            for(u64 i=0; i<count; ++i){
+                sampler.push(random, i);
+            }
+            return sampler.samples()[0];
+        });
+        benchmark.run("WeightedReservoirSampler(k=1000)::push", 4, [&](u64 count){
+            WeightedReservoirSampler<u64> sampler(1000);
+            for(u64 i=0; i<count; ++i){
+                sampler.push(random, i, 1.0 + static_cast<f64>(i&7));
+            }
+            return sampler[0];
+        });
+        std::vector<u64> selected(1000);
+        benchmark.run("sampleWithoutReplacement(1000 of 1G)", 8, [&](u64 count){
+            u64 s = 0;
+            while(0<count){
+                u64 n = (selected.size()<count)? selected.size() : count;
+                sampleWithoutReplacement(random, &selected[0], static_cast<u32>(n), 1000000000ULL);
+                s += selected[0];
+                count -= n;
+            }
+            return s;
+        });
+
+        //Per 64 bytes call
+        benchmark.run("cryptRandom(64 bytes)", 64, [&](u64 count){
+            u64 s = 0;
+            u8 buffer[64];
+            for(u64 i=0; i<count; ++i){
+                cryptRandom(sizeof(buffer), buffer);
+                s += buffer[0];
+            }
+            return s;
+        });
+        benchmark.run("cryptRandom(4096 bytes)", 4096, [&](u64 count){
+            u64 s = 0;
+            static u8 buffer[4096];
+            for(u64 i=0; i<count; ++i){
+                cryptRandom(sizeof(buffer), buffer);
+                s += buffer[0];
+            }
+            return s;
+        });
+    }
+
+    //---------------------------------------------
+    void writeCSV(const Char* filename, const std::vector<Result>& results)
+    {
+        FILE* file = fopen(filename, "wb");
+        if(NULL == file){
+            fprintf(stderr, "cannot open %s\n", filename);
+            return;
+        }
+        fprintf(file, "name,bytes_per_value,iterations,ns_median,ns_min,ns_max,ns_mean,ns_stddev,cycles_per_byte\n");
+        for(size_t i=0; i<results.size(); ++i){
+            const Result& r = results[i];
+            fprintf(file, "\"%s\",%u,%llu,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n",
+                r.name_.c_str(), r.bytesPerValue_, static_cast<unsigned long long>(r.iterations_),
+                r.nanoseconds_.median_, r.nanoseconds_.min_, r.nanoseconds_.max_, r.nanoseconds_.mean_, r.nanoseconds_.stddev_,
+                r.cyclesPerByte_);
+        }
+        fclose(file);
+    }
+
+    void writeJSON(const Char* filename, const Benchmark& benchmark)
+    {
+        FILE* file = fopen(filename, "wb");
+        if(NULL == file){
+            fprintf(stderr, "cannot open %s\n", filename);
+            return;
+        }
+#if defined(__clang__)
+        const Char* compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+        const Char* compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        const Char* compiler = "msvc";
+#else
+        const Char* compiler = "unknown";
+#endif
+        fprintf(file, "{\n");
+        fprintf(file, "  \"timestamp\": %lld,\n", static_cast<long long>(time(NULL)));
+        fprintf(file, "  \"compiler\": \"%s\",\n", compiler);
+        fprintf(file, "  \"isa\": \"%s\",\n", getRandomISAName(getRandomISA()));
+        fprintf(file, "  \"warmups\": %u,\n", benchmark.warmups_);
+        fprintf(file, "  \"repetitions\": %u,\n", benchmark.repetitions_);
+        fprintf(file, "  \"results\": [\n");
+        const std::vector<Result>& results = benchmark.getResults();
+        for(size_t i=0; i<results.size(); ++i){
+            const Result& r = results[i];
+            fprintf(file, "    {\"name\": \"%s\", \"bytes_per_value\": %u, \"iterations\": %llu, "
+                "\"ns_median\": %.6f, \"ns_min\": %.6f, \"ns_max\": %.6f, \"ns_mean\": %.6f, \"ns_stddev\": %.6f, "
+                "\"cycles_per_byte\": %.6f}%s\n",
+                r.name_.c_str(), r.bytesPerValue_, static_cast<unsigned long long>(r.iterations_),
+                r.nanoseconds_.median_, r.nanoseconds_.min_, r.nanoseconds_.max_, r.nanoseconds_.mean_, r.nanoseconds_.stddev_,
+                r.cyclesPerByte_, (i+1<results.size())? "," : "");
+        }
+        fprintf(file, "  ]\n}\n");
+        fclose(file);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Benchmark benchmark;
+    const Char* csv = NULL;
+    const Char* json = NULL;
+    for(int i=1; i<argc; ++i){
+        if(i+1<argc && 0 == strcmp(argv[i], "--reps")){
+            benchmark.repetitions_ = static_cast<u32>(atoi(argv[++i]));
+        }else if(i+1<argc && 0 == strcmp(argv[i], "--warmup")){
+            benchmark.warmups_ = static_cast<u32>(atoi(argv[++i]));
+        }else if(i+1<argc && 0 == strcmp(argv[i], "--time")){
+            benchmark.seconds_ = atof(argv[++i]);
+        }else if(i+1<argc && 0 == strcmp(argv[i], "--filter")){
+            benchmark.filter_ = argv[++i];
+        }else if(i+1<argc && 0 == strcmp(argv[i], "--csv")){
+            csv = argv[++i];
+        }else if(i+1<argc && 0 == strcmp(argv[i], "--json")){
+            json = argv[++i];
+        }else{
+            fprintf(stderr, "usage: TestRandomBench [--reps N] [--warmup N] [--time seconds] [--filter text] [--csv file] [--json file]\n");
+            return 1;
+        }
+    }
+    benchmark.repetitions_ = (benchmark.repetitions_<1)? 1 : benchmark.repetitions_;
+
+    printf("kernels: %s, warmups: %u, repetitions: %u\n", getRandomISAName(getRandomISA()), benchmark.warmups_, benchmark.repetitions_);
+    printf("%-36s %10s %10s %10s %9s %10s\n", "name", "ns median", "ns min", "ns mean", "stddev", "cycles/B");
+
+    bench32<Xoshiro128Plus>(benchmark, "Xoshiro128Plus");
+    bench32<Xoshiro128Star>(benchmark, "Xoshiro128Star");
+    bench32<RandWELL>(benchmark, "RandWELL");
+    bench64<Xoroshiro128Plus>(benchmark, "Xoroshiro128Plus");
+    bench64<Xoroshiro256Plus>(benchmark, "Xoroshiro256Plus");
+    bench64<Xoroshiro512Plus>(benchmark, "Xoroshiro512Plus");
+    bench64<Xoshiro256StarStar>(benchmark, "Xoshiro256StarStar");
+    bench64<PCG64DXSM>(benchmark, "PCG64DXSM");
+    bench64<SFC64>(benchmark, "SFC64");
+    bench64<RomuTrio>(benchmark, "RomuTrio");
+    benchCounter<PhiloxRandom>(benchmark, "PhiloxRandom");
+    benchCounter<SquaresRandom>(benchmark, "SquaresRandom");
+    benchStd<std::mt19937>(benchmark, "std::mt19937");
+    benchStd<std::mt19937_64>(benchmark, "std::mt19937_64");
+    benchStd<Xoshiro128PlusEngine>(benchmark, "Xoshiro128PlusEngine");
+    benchStd<Xoshiro128StarEngine>(benchmark, "Xoshiro128StarEngine");
+    benchStd<Xoroshiro128PlusEngine>(benchmark, "Xoroshiro128PlusEngine");
+    benchStd<Xoroshiro256PlusEngine>(benchmark, "Xoroshiro256PlusEngine");
+    benchStd<Xoroshiro512PlusEngine>(benchmark, "Xoroshiro512PlusEngine");
+    benchStd<Xoshiro128PlusPlusEngine>(benchmark, "Xoshiro128PlusPlusEngine");
+    benchStd<Xoshiro256StarStarEngine>(benchmark, "Xoshiro256StarStarEngine");
+    benchRegistry(benchmark);
+    benchHelpers(benchmark);
+    benchDistributions(benchmark);
+
+#ifdef LCORE_PERF_COUNTER
+    printf("\n");
+    printPerfCounters(stdout);
+#endif
+
+    if(NULL != csv){
+        writeCSV(csv, benchmark.getResults());
+    }
+    if(NULL != json){
+        writeJSON(json, benchmark);
+    }
+    return 0;
+}
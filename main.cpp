@@ -1,27 +1,942 @@
 #include "Random.h"
-#include <fstream>
+#include "RandomRegistry.h"
+#include "RandomKernel.h"
+#include "RandomCounter.h"
+#include "RandomPermutation.h"
+#include "PerfCounter.h"
+#include "RandomTest.h"
+#include "RandomThread.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
 
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <malloc.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
 
+namespace
+{
+    static const lcore::u32 PageSize = 4096;
+
+    void* alignedMalloc(lcore::size_t size)
+    {
+#ifdef _WIN32
+        return _aligned_malloc(size, PageSize);
+#else
+        void* ptr = NULL;
+        return (0 == posix_memalign(&ptr, PageSize, size))? ptr : NULL;
+#endif
+    }
+
+    void alignedFree(void* ptr)
+    {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+    }
+
+    //---------------------------------------------
+    /**
+    @brief Sequential file writer, bypasses the page cache where the file system allows
+    */
+    class ChunkWriter
+    {
+    public:
+        ChunkWriter()
+#ifdef _WIN32
+            :file_(NULL)
+#else
+            :fd_(-1)
+            ,direct_(false)
+#endif
+        {}
+
+        ~ChunkWriter()
+        {
+            close();
+        }
+
+        bool open(const lcore::Char* filename)
+        {
+            close();
+#ifdef _WIN32
+            file_ = fopen(filename, "wb");
+            return NULL != file_;
+#else
+#ifdef O_DIRECT
+            fd_ = ::open(filename, O_WRONLY|O_CREAT|O_TRUNC|O_DIRECT, 0644);
+            direct_ = 0<=fd_;
+#endif
+            if(fd_<0){
+                fd_ = ::open(filename, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+            }
+            return 0<=fd_;
+#endif
+        }
+
+        /**
+        @return false if the file did not close cleanly, which may lose written data
+        */
+        bool close()
+        {
+            bool result = true;
+#ifdef _WIN32
+            if(NULL != file_){
+                result = 0 == fclose(file_);
+                file_ = NULL;
+            }
+#else
+            if(0<=fd_){
+                result = 0 == ::close(fd_);
+                fd_ = -1;
+            }
+#endif
+            return result;
+        }
+
+        /**
+        @brief Write whole of a page aligned buffer
+        */
+        bool write(const void* buffer, lcore::size_t size)
+        {
+#ifdef _WIN32
+            return size == fwrite(buffer, 1, size, file_);
+#else
+            const lcore::u8* p = static_cast<const lcore::u8*>(buffer);
+            while(0<size){
+                ssize_t written = ::write(fd_, p, size);
+                if(written<0){
+                    if(EINTR == errno){
+                        continue;
+                    }
+#ifdef O_DIRECT
+                    //Some file systems refuse direct I/O only at write
+                    if(EINVAL == errno && direct_){
+                        direct_ = false;
+                        fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) & ~O_DIRECT);
+                        continue;
+                    }
+#endif
+                    return false;
+                }
+                p += written;
+                size -= static_cast<lcore::size_t>(written);
+            }
+            return true;
+#endif
+        }
+
+    private:
+#ifdef _WIN32
+        FILE* file_;
+#else
+        lcore::s32 fd_;
+        bool direct_;
+#endif
+    };
+
+    //---------------------------------------------
+    template<class T>
+    auto getFillLanes(int) -> std::integral_constant<lcore::u32, T::FillLanes>;
+
+    template<class T>
+    auto getFillLanes(long) -> std::integral_constant<lcore::u32, 1>;
+
+    typedef std::vector<std::vector<lcore::u32> > LanePrefixes;
+
+    /**
+    @brief Append the first values of each lane of an output of fill() with the given lanes
+    */
+    void appendLanePrefixes(LanePrefixes& prefixes, const std::vector<lcore::u32>& values, lcore::u32 lanes)
+    {
+        const lcore::size_t length = values.size()/lanes;
+        for(lcore::u32 k=0; k<lanes; ++k){
+            std::vector<lcore::u32> prefix(length);
+            for(lcore::size_t j=0; j<length; ++j){
+                prefix[j] = values[lanes*j + k];
+            }
+            prefixes.push_back(prefix);
+        }
+    }
+
+    /**
+    @brief Whether no two prefixes are the same
+    */
+    bool isDisjoint(LanePrefixes& prefixes)
+    {
+        std::sort(prefixes.begin(), prefixes.end());
+        return prefixes.end() == std::adjacent_find(prefixes.begin(), prefixes.end());
+    }
+
+    /**
+    @brief Whether no two lanes of fill() of the streams begin with the same values
+
+    A lane which reaches the start of another lane or stream repeats its prefix, so this finds overlapping streams.
+    */
+    template<class T>
+    bool hasDisjointPrefixes(const T* streams, lcore::size_t num)
+    {
+        static const lcore::u32 Lanes = decltype(getFillLanes<T>(0))::value;
+        static const lcore::u32 Prefix = 4;
+        std::vector<lcore::u32> values(Lanes*Prefix);
+        LanePrefixes prefixes;
+        prefixes.reserve(num*Lanes);
+        for(lcore::size_t i=0; i<num; ++i){
+            T random(streams[i]);
+            random.fill(&values[0], values.size());
+            appendLanePrefixes(prefixes, values, Lanes);
+        }
+        return isDisjoint(prefixes);
+    }
+
+    //---------------------------------------------
+    /**
+    @brief Generators for each chunk, chunk i starts i streams of StreamFactory after the seed
+
+    The streams are FillLanes jumps apart, so the lanes of fill() of a chunk do not reach the next chunks.
+    */
+    template<class T>
+    void createChunkStreams(std::vector<T>& streams, lcore::u32 seed, lcore::u64)
+    {
+        lcore::StreamFactory<T> factory((T(seed)));
+        factory.create(&streams[0], static_cast<lcore::u32>(streams.size()));
+    }
+
+    /**
+    @brief RandWELL can skip any distance, so the chunks form one sequential stream
+    */
+    template<>
+    void createChunkStreams<lcore::RandWELL>(std::vector<lcore::RandWELL>& streams, lcore::u32 seed, lcore::u64 valuesPerChunk)
+    {
+        lcore::RandWELL random(seed);
+        for(lcore::size_t i=0; i<streams.size(); ++i){
+            streams[i] = random;
+            random.discard(valuesPerChunk);
+        }
+    }
+}
+
+/**
+@brief Write 2 GiB of fill() output of the chunk streams, chunk after chunk
+
+Worker threads fill chunks into double buffers, and this thread writes them in order.
+@return false if the file is not the whole output
+*/
 template<class T>
-void output32(lcore::u32 seed, const lcore::Char* filename)
+bool output32(lcore::u32 seed, const lcore::Char* filename)
 {
-    std::ofstream file(filename, std::ios::binary);
-    if(!file.is_open()){
-        return;
+    static const lcore::u64 Size = 2ULL * 1024 * 1024 * 1024;
+    static const lcore::u32 ChunkSize = 8 * 1024 * 1024;
+    static const lcore::u32 NumChunks = static_cast<lcore::u32>(Size/ChunkSize);
+    static const lcore::u32 ValuesPerChunk = ChunkSize/sizeof(lcore::u32);
+
+    ChunkWriter writer;
+    if(!writer.open(filename)){
+        fprintf(stderr, "%s: can not open\n", filename);
+        return false;
+    }
+
+    lcore::u32 numWorkers = std::thread::hardware_concurrency();
+    numWorkers = (numWorkers<1)? 1 : numWorkers;
+    numWorkers = (NumChunks<numWorkers)? NumChunks : numWorkers;
+    const lcore::u32 numSlots = 2*numWorkers;
+
+    std::vector<T> streams(NumChunks);
+    createChunkStreams(streams, seed, ValuesPerChunk);
+    if(!hasDisjointPrefixes(&streams[0], streams.size())){
+        fprintf(stderr, "%s: chunks share a prefix\n", filename);
+        writer.close();
+        return false;
+    }
+
+    //Chunk i goes to slot i%numSlots, after the writer has released chunk i-numSlots
+    struct Slot
+    {
+        lcore::u32* buffer_;
+        lcore::u32 next_;
+        bool ready_;
+    };
+    std::vector<Slot> slots(numSlots);
+    for(lcore::u32 i=0; i<numSlots; ++i){
+        slots[i].buffer_ = static_cast<lcore::u32*>(alignedMalloc(ChunkSize));
+        slots[i].next_ = i;
+        slots[i].ready_ = false;
+        if(NULL == slots[i].buffer_){
+            for(lcore::u32 j=0; j<i; ++j){
+                alignedFree(slots[j].buffer_);
+            }
+            fprintf(stderr, "%s: can not allocate buffers\n", filename);
+            writer.close();
+            return false;
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool abort = false;
+
+    std::vector<std::thread> workers;
+    for(lcore::u32 w=0; w<numWorkers; ++w){
+        workers.push_back(std::thread([&, w](){
+            for(lcore::u32 chunk=w; chunk<NumChunks; chunk+=numWorkers){
+                Slot& slot = slots[chunk%numSlots];
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock, [&](){ return abort || slot.next_ == chunk;});
+                    if(abort){
+                        return;
+                    }
+                }
+                {
+                    LCORE_PERF_SCOPE(filename, ValuesPerChunk);
+                    streams[chunk].fill(slot.buffer_, ValuesPerChunk);
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slot.ready_ = true;
+                }
+                condition.notify_all();
+            }
+        }));
+    }
+
+    bool written = true;
+    for(lcore::u32 chunk=0; chunk<NumChunks; ++chunk){
+        Slot& slot = slots[chunk%numSlots];
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&](){ return slot.ready_ && slot.next_ == chunk;});
+        }
+        bool result = writer.write(slot.buffer_, ChunkSize);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            slot.ready_ = false;
+            slot.next_ = chunk + numSlots;
+            abort = !result;
+        }
+        condition.notify_all();
+        if(!result){
+            written = false;
+            break;
+        }
+    }
+
+    for(lcore::size_t i=0; i<workers.size(); ++i){
+        workers[i].join();
+    }
+    for(lcore::u32 i=0; i<numSlots; ++i){
+        alignedFree(slots[i].buffer_);
+    }
+    written = writer.close() && written;
+    if(!written){
+        fprintf(stderr, "%s: can not write\n", filename);
+    }
+    return written;
+}
+
+namespace
+{
+    //---------------------------------------------
+    /**
+    @brief Unbounded raw output to stdout or a file, zero copy into pipes on Linux
+
+    For a pipe, each buffer is as large as the pipe capacity.
+    When vmsplice of one buffer has completed, the pipe holds no page of the other one,
+    so the other buffer can be refilled while the reader consumes this one.
+    */
+    class StreamWriter
+    {
+    public:
+        StreamWriter()
+            :buffers_{NULL, NULL}
+            ,size_(0)
+            ,current_(0)
+#ifdef _WIN32
+            ,file_(NULL)
+#else
+            ,fd_(-1)
+            ,pipe_(false)
+#endif
+        {}
+
+        ~StreamWriter()
+        {
+            close();
+        }
+
+        /**
+        @param filename ... NULL for stdout
+        */
+        bool open(const lcore::Char* filename)
+        {
+            close();
+            size_ = DefaultSize;
+#ifdef _WIN32
+            if(NULL == filename){
+                _setmode(_fileno(stdout), _O_BINARY);
+                file_ = stdout;
+            }else{
+                file_ = fopen(filename, "wb");
+            }
+            if(NULL == file_){
+                return false;
+            }
+#else
+            //A closed reader ends the stream by EPIPE
+            signal(SIGPIPE, SIG_IGN);
+            fd_ = (NULL == filename)? STDOUT_FILENO : ::open(filename, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+            if(fd_<0){
+                return false;
+            }
+            struct stat st;
+            pipe_ = (0 == fstat(fd_, &st)) && S_ISFIFO(st.st_mode);
+#if defined(F_SETPIPE_SZ) && defined(F_GETPIPE_SZ)
+            if(pipe_){
+                fcntl(fd_, F_SETPIPE_SZ, static_cast<int>(DefaultSize));
+                int pipeSize = fcntl(fd_, F_GETPIPE_SZ);
+                if(0<pipeSize){
+                    size_ = static_cast<lcore::u32>(pipeSize);
+                }
+            }
+#else
+            pipe_ = false;
+#endif
+#endif
+            for(lcore::u32 i=0; i<2; ++i){
+                buffers_[i] = alignedMalloc(size_);
+                if(NULL == buffers_[i]){
+                    close();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void close()
+        {
+#ifdef _WIN32
+            if(NULL != file_ && stdout != file_){
+                fclose(file_);
+            }
+            file_ = NULL;
+#else
+            if(STDOUT_FILENO<fd_){
+                ::close(fd_);
+            }
+            fd_ = -1;
+#endif
+            for(lcore::u32 i=0; i<2; ++i){
+                alignedFree(buffers_[i]);
+                buffers_[i] = NULL;
+            }
+        }
+
+        void* getBuffer()
+        {
+            return buffers_[current_];
+        }
+
+        lcore::u32 getSize() const
+        {
+            return size_;
+        }
+
+        /**
+        @brief Send the buffer returned by getBuffer, and switch to the other one
+        */
+        bool flush()
+        {
+            const lcore::u8* p = static_cast<const lcore::u8*>(buffers_[current_]);
+            current_ ^= 1;
+#ifdef _WIN32
+            return size_ == fwrite(p, 1, size_, file_);
+#else
+            lcore::size_t size = size_;
+            while(0<size){
+                ssize_t written;
+#if defined(__linux__)
+                if(pipe_){
+                    struct iovec iov;
+                    iov.iov_base = const_cast<lcore::u8*>(p);
+                    iov.iov_len = size;
+                    written = vmsplice(fd_, &iov, 1, 0);
+                    if(written<0 && EINTR != errno){
+                        //Not supported, copy from now on
+                        pipe_ = false;
+                        continue;
+                    }
+                }else
+#endif
+                {
+                    written = ::write(fd_, p, size);
+                }
+                if(written<0){
+                    if(EINTR == errno){
+                        continue;
+                    }
+                    return false;
+                }
+                p += written;
+                size -= static_cast<lcore::size_t>(written);
+            }
+            return true;
+#endif
+        }
+
+    private:
+        static const lcore::u32 DefaultSize = 1024 * 1024;
+
+        void* buffers_[2];
+        lcore::u32 size_;
+        lcore::u32 current_;
+#ifdef _WIN32
+        FILE* file_;
+#else
+        lcore::s32 fd_;
+        bool pipe_;
+#endif
+    };
+
+    //---------------------------------------------
+    /**
+    @brief Write rand() output until the reader closes
+    */
+    bool outputStream(const lcore::RandomGeneratorInfo& info, lcore::u64 seed, const lcore::Char* filename)
+    {
+        StreamWriter writer;
+        if(!writer.open(filename)){
+            return false;
+        }
+        lcore::AnyRandom random(info, seed);
+        do{
+            random.fill(static_cast<lcore::u32*>(writer.getBuffer()), writer.getSize()/sizeof(lcore::u32));
+        }while(writer.flush());
+        return true;
+    }
+
+    /**
+    @brief Raw output of a generator as a source of the tests
+    */
+    class GeneratorSource : public lcore::RandomTestSource
+    {
+    public:
+        GeneratorSource(const lcore::RandomGeneratorInfo& info, lcore::u64 seed)
+            :random_(info, seed)
+        {}
+
+        virtual void fill(lcore::u32* words, lcore::size_t size)
+        {
+            random_.fill(words, size);
+        }
+    private:
+        lcore::AnyRandom random_;
+    };
+
+    /**
+    @brief Run the statistical tests, and print results in the table style of README
+    @return false if any test failed
+    */
+    bool checkQuality(const lcore::RandomGeneratorInfo& info, lcore::u64 seed, lcore::u32 psamples, bool header)
+    {
+        GeneratorSource source(info, seed);
+        std::vector<lcore::RandomTestResult> results;
+        lcore::runRandomTests(results, source, psamples);
+        lcore::printRandomTestResults(stdout, info.name_, results, false, header);
+        fflush(stdout);
+        for(lcore::size_t i=0; i<results.size(); ++i){
+            if(lcore::RandomTestAssessment_Failed == results[i].assessment_){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+    @brief Check that the streams of StreamFactory do not overlap, through all lanes of fill()
+    */
+    template<class T>
+    bool checkStreamFactory(const lcore::Char* name, lcore::u64 seed)
+    {
+        std::vector<T> streams(64);
+        lcore::StreamFactory<T> factory((T(static_cast<lcore::u32>(seed))));
+        factory.create(&streams[0], static_cast<lcore::u32>(streams.size()));
+        const bool result = hasDisjointPrefixes(&streams[0], streams.size());
+        printf("%-36s %s\n", name, result? "PASSED" : "FAILED");
+        return result;
+    }
+
+    /**
+    @brief Check that threadRandom() of different threads do not overlap, through all lanes of fill()
+    */
+    bool checkThreadRandom(lcore::u64 seed)
+    {
+        static const lcore::u32 NumThreads = 8;
+        static const lcore::u32 Lanes = decltype(getFillLanes<lcore::ThreadRandomGenerator>(0))::value;
+        static const lcore::u32 Prefix = 4;
+        lcore::setThreadRandomSeed(seed);
+        std::vector<std::vector<lcore::u32> > outputs(NumThreads, std::vector<lcore::u32>(Lanes*Prefix));
+        std::vector<std::thread> threads;
+        for(lcore::u32 i=0; i<NumThreads; ++i){
+            std::vector<lcore::u32>& output = outputs[i];
+            threads.push_back(std::thread([&output](){
+                lcore::threadRandom().fill(&output[0], output.size());
+            }));
+        }
+        for(lcore::u32 i=0; i<NumThreads; ++i){
+            threads[i].join();
+        }
+        LanePrefixes prefixes;
+        for(lcore::u32 i=0; i<NumThreads; ++i){
+            appendLanePrefixes(prefixes, outputs[i], Lanes);
+        }
+        const bool result = isDisjoint(prefixes);
+        printf("%-36s %s\n", "threadRandom", result? "PASSED" : "FAILED");
+        return result;
+    }
+
+    /**
+    @brief Check that discard(n) of RandWELL equals n calls of rand(), from a fresh seed and from the middle of a block
+    */
+    bool checkDiscard(lcore::u64 seed)
+    {
+        static const lcore::u64 Counts[4] = {1, 511, 512, 100003};
+        static const lcore::u32 Offsets[2] = {0, 5};
+        bool result = true;
+        for(lcore::u32 i=0; i<4; ++i){
+            for(lcore::u32 j=0; j<2; ++j){
+                lcore::RandWELL discarded(static_cast<lcore::u32>(seed));
+                lcore::RandWELL stepped(static_cast<lcore::u32>(seed));
+                for(lcore::u32 k=0; k<Offsets[j]; ++k){
+                    discarded.rand();
+                    stepped.rand();
+                }
+                discarded.discard(Counts[i]);
+                for(lcore::u64 k=0; k<Counts[i]; ++k){
+                    stepped.rand();
+                }
+                for(lcore::u32 k=0; k<64; ++k){
+                    result = result && discarded.rand() == stepped.rand();
+                }
+            }
+        }
+        printf("%-36s %s\n", "RandWELL::discard", result? "PASSED" : "FAILED");
+        return result;
+    }
+
+    /**
+    @brief Checks of disjoint streams
+    @return false if any check failed
+    */
+    bool checkStreams(lcore::u64 seed)
+    {
+        bool result = true;
+        result = checkStreamFactory<lcore::Xoshiro128Plus>("StreamFactory<Xoshiro128Plus>", seed) && result;
+        result = checkStreamFactory<lcore::Xoshiro128Star>("StreamFactory<Xoshiro128Star>", seed) && result;
+        result = checkStreamFactory<lcore::Xoshiro128PlusPlus>("StreamFactory<Xoshiro128PlusPlus>", seed) && result;
+        result = checkThreadRandom(seed) && result;
+        result = checkDiscard(seed) && result;
+        fflush(stdout);
+        return result;
+    }
+
+    bool printKernelCheck(const lcore::Char* name, lcore::RandomISA isa, bool result)
+    {
+        lcore::Char label[64];
+        snprintf(label, sizeof(label), "%s (%s)", name, lcore::getRandomISAName(isa));
+        printf("%-36s %s\n", label, result? "PASSED" : "FAILED");
+        return result;
+    }
+
+    /**
+    @brief Check the ChaCha20 kernels with the test vector of RFC 8439 2.3.2, one block in the scalar tail and 16 in the vectors
+    */
+    bool checkChaCha20(const lcore::RandomKernels& kernels)
+    {
+        static const lcore::u32 Expected[16] =
+        {
+            0xe4e7f110U, 0x15593bd1U, 0x1fdd0f50U, 0xc47120a3U, 0xc7f4d1c7U, 0x0368c033U, 0x9aaa2204U, 0x4e6cd4c3U,
+            0x466482d2U, 0x09aa9f07U, 0x05d7c214U, 0xa2028bd9U, 0xd19c12b5U, 0xb94e16deU, 0xe883d0cbU, 0x4e3c50a2U,
+        };
+        //Key 00 01 ... 1f, counter 1 and nonce 00 00 00 09 00 00 00 4a 00 00 00 00,
+        //the 64 bit counter of the kernels takes the first nonce word as its upper half
+        lcore::u32 state[16] = {0x61707865U, 0x3320646eU, 0x79622d32U, 0x6b206574U};
+        for(lcore::u32 i=0; i<8; ++i){
+            state[4+i] = 0x03020100U + 0x04040404U*i;
+        }
+        state[12] = 1;
+        state[13] = 0x09000000U;
+        state[14] = 0x4a000000U;
+        state[15] = 0;
+
+        lcore::u32 out[16*16];
+        kernels.chacha20_(out, state, 1);
+        bool result = 0 == memcmp(out, Expected, sizeof(Expected));
+        kernels.chacha20_(out, state, 16);
+        result = result && 0 == memcmp(out, Expected, sizeof(Expected));
+        return printKernelCheck("ChaCha20 RFC 8439", kernels.isa_, result);
     }
-    static const lcore::u32 Size = 2UL * 1024 * 1024 * 1024;
-    T random(seed);
-    for(lcore::u32 i=0; i<Size/sizeof(lcore::u32); ++i){
-        lcore::u32 x = random.rand();
-        file.write(reinterpret_cast<const char*>(&x), sizeof(lcore::u32));
+
+    /**
+    @brief Check the Philox4x32-10 kernels with the known answers of Random123, one block in the scalar tail and 16 in the vectors
+    */
+    bool checkPhilox4x32(const lcore::RandomKernels& kernels)
+    {
+        //Counter words, key words, then the block
+        static const lcore::u32 Vectors[3][10] =
+        {
+            {0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U},
+            {0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU, 0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU},
+            {0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U, 0xa4093822U, 0x299f31d0U, 0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U},
+        };
+        bool result = true;
+        lcore::u32 out[4*16];
+        for(lcore::u32 i=0; i<3; ++i){
+            const lcore::u32* v = Vectors[i];
+            const lcore::u64 counter = (static_cast<lcore::u64>(v[1])<<32) | v[0];
+            const lcore::u64 stream = (static_cast<lcore::u64>(v[3])<<32) | v[2];
+            const lcore::u64 key = (static_cast<lcore::u64>(v[5])<<32) | v[4];
+            kernels.philox4x32_(out, key, stream, counter, 1);
+            result = result && 0 == memcmp(out, v+6, 4*sizeof(lcore::u32));
+            kernels.philox4x32_(out, key, stream, counter, 16);
+            result = result && 0 == memcmp(out, v+6, 4*sizeof(lcore::u32));
+        }
+        return printKernelCheck("Philox4x32-10 Random123", kernels.isa_, result);
+    }
+
+    /**
+    @brief Check that the batches of the kernels equal the scalar functions, over the tails of every size up to MaxSize
+    */
+    bool checkKernelBatches(const lcore::RandomKernels& kernels)
+    {
+        static const lcore::u32 MaxSize = 67;
+        static const lcore::u32 Ranges[2] = {1000U, 0xC0000001U};
+        static const lcore::u32 HalfBits[3] = {1, 17, 32};
+        const lcore::RandomKernels& scalar = lcore::getRandomKernels(lcore::RandomISA_Scalar);
+        const lcore::u64 key = 0x243f6a8885a308d3ULL;
+        const lcore::u64 stream = 0x13198a2e03707344ULL;
+        const lcore::u64 counter = 0xFFFFFFF0ULL; //The lower counter words wrap inside the batches
+        const lcore::Philox4x32::Key philoxKey = lcore::Philox4x32::makeKey(key, stream);
+        const lcore::Squares32::Key squaresKey = lcore::Squares32::makeKey(key, stream);
+
+        lcore::u32 state[16];
+        lcore::u64 keys[lcore::RandomPermutation::Rounds];
+        lcore::SplitMix64 random(key);
+        for(lcore::u32 i=0; i<16; ++i){
+            state[i] = static_cast<lcore::u32>(random.rand());
+        }
+        state[12] = static_cast<lcore::u32>(counter);
+        state[13] = static_cast<lcore::u32>(counter>>32);
+        for(lcore::u32 i=0; i<lcore::RandomPermutation::Rounds; ++i){
+            keys[i] = random.rand();
+        }
+
+        std::vector<lcore::u32> out32(16*MaxSize+1);
+        std::vector<lcore::u32> expected32(16*MaxSize+1);
+        std::vector<lcore::u64> in64(MaxSize+1);
+        std::vector<lcore::u64> out64(MaxSize+1);
+        std::vector<lcore::u64> expected64(MaxSize+1);
+        bool result = true;
+        for(lcore::u32 n=0; n<=MaxSize; ++n){
+            kernels.philox4x32_(&out32[0], key, stream, counter, n);
+            for(lcore::u32 i=0; i<n; ++i){
+                lcore::Philox4x32::generate(&expected32[4*i], philoxKey, counter+i);
+            }
+            result = result && std::equal(out32.begin(), out32.begin()+4*n, expected32.begin());
+
+            kernels.chacha20_(&out32[0], state, n);
+            scalar.chacha20_(&expected32[0], state, n);
+            result = result && std::equal(out32.begin(), out32.begin()+16*n, expected32.begin());
+
+            kernels.squares32_(&out32[0], squaresKey.key_, counter, n);
+            for(lcore::u32 i=0; i<n; ++i){
+                expected32[i] = lcore::Squares32::squares(counter+i, squaresKey.key_);
+            }
+            result = result && std::equal(out32.begin(), out32.begin()+n, expected32.begin());
+
+            //Squares32 outputs as the bits of the bounded values
+            const std::vector<lcore::u32> bits(out32.begin(), out32.begin()+n+1);
+            for(lcore::u32 j=0; j<2; ++j){
+                const lcore::u32 threshold = (0U-Ranges[j]) % Ranges[j];
+                const bool rejected = 0 != kernels.mulHighU32_(&out32[0], &bits[0], n, Ranges[j], threshold);
+                bool expectedRejected = false;
+                for(lcore::u32 i=0; i<n; ++i){
+                    const lcore::u64 m = static_cast<lcore::u64>(bits[i]) * Ranges[j];
+                    expected32[i] = static_cast<lcore::u32>(m>>32);
+                    expectedRejected = expectedRejected || static_cast<lcore::u32>(m)<threshold;
+                }
+                result = result && rejected == expectedRejected && std::equal(out32.begin(), out32.begin()+n, expected32.begin());
+            }
+
+            kernels.splitMix64_(&out64[0], key, n);
+            for(lcore::u32 i=0; i<n; ++i){
+                expected64[i] = lcore::SplitMix64::mix(key + (i+1)*lcore::SplitMix64::Gamma);
+            }
+            result = result && std::equal(out64.begin(), out64.begin()+n, expected64.begin());
+
+            //SplitMix64 outputs as the indices of the Feistel network
+            for(lcore::u32 j=0; j<3; ++j){
+                const lcore::u64 mask = (32 == HalfBits[j])? ~0ULL : (1ULL<<(2*HalfBits[j])) - 1;
+                for(lcore::u32 i=0; i<n; ++i){
+                    in64[i] = expected64[i] & mask;
+                }
+                kernels.feistel64_(&out64[0], &in64[0], n, keys, lcore::RandomPermutation::Rounds, HalfBits[j]);
+                scalar.feistel64_(&in64[0], &in64[0], n, keys, lcore::RandomPermutation::Rounds, HalfBits[j]);
+                result = result && std::equal(out64.begin(), out64.begin()+n, in64.begin());
+            }
+        }
+        return printKernelCheck("Batches of the kernels", kernels.isa_, result);
+    }
+
+    /**
+    @brief Check that the batch functions equal their scalar ones, on the kernels selected by LCORE_RANDOM_ISA
+    */
+    bool checkBatches()
+    {
+        static const lcore::u32 Size = 1000;
+        const lcore::u64 key = 0xa4093822299f31d0ULL;
+        const lcore::u64 counter = 0xFFFFFF00ULL;
+        bool result = true;
+
+        std::vector<lcore::u32> out32(4*Size);
+        std::vector<lcore::u32> expected32(4*Size);
+        const lcore::Philox4x32::Key philoxKey = lcore::Philox4x32::makeKey(key, 1);
+        lcore::Philox4x32::generate(&out32[0], philoxKey, counter, Size);
+        for(lcore::u32 i=0; i<Size; ++i){
+            lcore::Philox4x32::generate(&expected32[4*i], philoxKey, counter+i);
+        }
+        result = result && out32 == expected32;
+
+        const lcore::Squares32::Key squaresKey = lcore::Squares32::makeKey(key, 1);
+        lcore::Squares32::generate(&out32[0], squaresKey, counter, Size);
+        for(lcore::u32 i=0; i<Size; ++i){
+            lcore::Squares32::generate(&expected32[i], squaresKey, counter+i);
+        }
+        result = result && std::equal(out32.begin(), out32.begin()+Size, expected32.begin());
+
+        std::vector<lcore::u64> out64(Size);
+        std::vector<lcore::u64> expected64(Size);
+        lcore::SplitMix64 random(key);
+        lcore::SplitMix64 expected(key);
+        random.fill(&out64[0], Size);
+        for(lcore::u32 i=0; i<Size; ++i){
+            expected64[i] = expected.rand();
+        }
+        result = result && out64 == expected64;
+
+        lcore::RandomPermutation permutation(random, 1000000007ULL);
+        permutation.fill(&out64[0], 1000000007ULL-Size, Size);
+        for(lcore::u32 i=0; i<Size; ++i){
+            expected64[i] = permutation[1000000007ULL-Size+i];
+        }
+        result = result && out64 == expected64;
+        permutation.map(&out64[0], &expected64[0], Size);
+        for(lcore::u32 i=0; i<Size; ++i){
+            result = result && out64[i] == permutation[expected64[i]];
+        }
+        return printKernelCheck("Selected batches", lcore::getRandomISA(), result);
+    }
+
+    /**
+    @brief Known answers and batches of the kernels of each instruction set supported
+    @return false if any check failed
+    */
+    bool checkKernels()
+    {
+        bool result = true;
+        for(lcore::u32 i=0; i<lcore::RandomISA_Num; ++i){
+            const lcore::RandomKernels& kernels = lcore::getRandomKernels(static_cast<lcore::RandomISA>(i));
+            if(kernels.isa_ != i){
+                continue;
+            }
+            result = checkChaCha20(kernels) && result;
+            result = checkPhilox4x32(kernels) && result;
+            result = checkKernelBatches(kernels) && result;
+        }
+        result = checkBatches() && result;
+        fflush(stdout);
+        return result;
+    }
+
+    void printUsage()
+    {
+        fprintf(stderr, "usage: TestRandom\n");
+        fprintf(stderr, "           write 2 GiB files of Xoshiro128Plus and WELL512\n");
+        fprintf(stderr, "       TestRandom stream generator [seed] [output]\n");
+        fprintf(stderr, "           write raw output until the reader closes, to stdout if output is omitted\n");
+        fprintf(stderr, "       TestRandom check generator|all [seed] [psamples]\n");
+        fprintf(stderr, "           run the statistical tests in memory, and fail if any test fails\n");
+        fprintf(stderr, "       TestRandom check streams [seed]\n");
+        fprintf(stderr, "           check that the streams of StreamFactory and threads do not overlap, and the jumps of discard\n");
+        fprintf(stderr, "       TestRandom check kernels\n");
+        fprintf(stderr, "           check the kernels of each instruction set with known answers and against their scalar loops\n");
+        fprintf(stderr, "generators:");
+        for(lcore::u32 i=0; i<lcore::getNumRandomGenerators(); ++i){
+            fprintf(stderr, " %s", lcore::getRandomGeneratorInfo(i).name_);
+        }
+        fprintf(stderr, "\n");
     }
-    file.close();
 }
 
-int main(int, char**)
+int main(int argc, char** argv)
 {
     lcore::u32 seed = 0x1234U;
-    output32<lcore::Xoshiro128Plus>(seed, "Xoshiro128Plus.byte");
-    output32<lcore::RandWELL>(seed, "WELL64.byte");
-    return 0;
+    if(argc<=1){
+        bool result = output32<lcore::Xoshiro128Plus>(seed, "Xoshiro128Plus.byte");
+        result = output32<lcore::RandWELL>(seed, "WELL64.byte") && result;
+        lcore::printPerfCounters(stderr);
+        return result? 0 : 1;
+    }
+
+    if(0 == strcmp(argv[1], "stream") && 3<=argc){
+        const lcore::RandomGeneratorInfo* generator = lcore::findRandomGenerator(argv[2]);
+        if(NULL == generator){
+            printUsage();
+            return 1;
+        }
+        lcore::u64 streamSeed = (4<=argc)? strtoull(argv[3], NULL, 0) : seed;
+        const lcore::Char* filename = (5<=argc)? argv[4] : NULL;
+        return outputStream(*generator, streamSeed, filename)? 0 : 1;
+    }
+
+    if(0 == strcmp(argv[1], "check") && 3<=argc){
+        lcore::u64 checkSeed = (4<=argc)? strtoull(argv[3], NULL, 0) : seed;
+        lcore::u32 psamples = (5<=argc)? static_cast<lcore::u32>(strtoul(argv[4], NULL, 0)) : 100;
+        if(0 == strcmp(argv[2], "streams")){
+            return checkStreams(checkSeed)? 0 : 1;
+        }
+        if(0 == strcmp(argv[2], "kernels")){
+            return checkKernels()? 0 : 1;
+        }
+        if(0 == strcmp(argv[2], "all")){
+            bool result = true;
+            for(lcore::u32 i=0; i<lcore::getNumRandomGenerators(); ++i){
+                result = checkQuality(lcore::getRandomGeneratorInfo(i), checkSeed, psamples, 0 == i) && result;
+            }
+            return result? 0 : 1;
+        }
+        const lcore::RandomGeneratorInfo* generator = lcore::findRandomGenerator(argv[2]);
+        if(NULL == generator){
+            printUsage();
+            return 1;
+        }
+        return checkQuality(*generator, checkSeed, psamples, true)? 0 : 1;
+    }
+    printUsage();
+    return 1;
 }